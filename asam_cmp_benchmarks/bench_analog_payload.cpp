@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include <coreobjects/unit_factory.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/packet_factory.h>
+
+#include <asam_cmp_capture_module/analog_payload_builder.h>
+
+using namespace daq;
+using daq::modules::asam_cmp_capture_module::createAnalogPayloadWithInternalScaling;
+
+namespace
+{
+
+constexpr Float analogDataScale = 1e-3;
+constexpr Float analogDataOffset = 0;
+constexpr Float analogDataDeltaTime = 20e-6;
+
+template <SampleType SrcType>
+void BM_AnalogPayloadWithInternalScaling(benchmark::State& state)
+{
+    using SourceType = typename SampleTypeToType<SrcType>::Type;
+
+    const size_t sampleCount = state.range(0);
+    const auto descriptor = DataDescriptorBuilder().setSampleType(SrcType).setUnit(Unit("V")).build();
+    const auto packet = DataPacket(descriptor, sampleCount);
+
+    auto* data = static_cast<SourceType*>(packet.getRawData());
+    for (size_t i = 0; i < sampleCount; ++i)
+        data[i] = static_cast<SourceType>(i % 100);
+
+    for (auto _ : state)
+    {
+        ASAM::CMP::AnalogPayload payload;
+        createAnalogPayloadWithInternalScaling<SrcType>(payload, packet, analogDataScale, analogDataOffset, analogDataDeltaTime);
+        benchmark::DoNotOptimize(payload);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sampleCount);
+}
+
+}  // namespace
+
+// 350 samples is the largest analog message that fits into a single 1500 byte frame after scaling to int32
+#define ANALOG_SCALING_BENCHMARK(ST) BENCHMARK_TEMPLATE(BM_AnalogPayloadWithInternalScaling, ST)->Arg(80)->Arg(350)
+
+ANALOG_SCALING_BENCHMARK(SampleType::Int8);
+ANALOG_SCALING_BENCHMARK(SampleType::Int16);
+ANALOG_SCALING_BENCHMARK(SampleType::Int32);
+ANALOG_SCALING_BENCHMARK(SampleType::Int64);
+ANALOG_SCALING_BENCHMARK(SampleType::UInt8);
+ANALOG_SCALING_BENCHMARK(SampleType::UInt16);
+ANALOG_SCALING_BENCHMARK(SampleType::UInt32);
+ANALOG_SCALING_BENCHMARK(SampleType::UInt64);
+ANALOG_SCALING_BENCHMARK(SampleType::Float32);
+ANALOG_SCALING_BENCHMARK(SampleType::Float64);
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+#include <coreobjects/util.h>
+#include <opendaq/module_manager_init.h>
+
+int main(int argc, char** args)
+{
+    using namespace daq;
+
+    daqInitModuleManagerLibrary();
+
+    benchmark::Initialize(&argc, args);
+    if (benchmark::ReportUnrecognizedArguments(argc, args))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
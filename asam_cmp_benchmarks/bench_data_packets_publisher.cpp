@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <coretypes/intfs.h>
+#include <memory>
+
+#include <asam_cmp_data_sink/data_packets_publisher.h>
+
+using namespace daq;
+
+using ASAM::CMP::Packet;
+using daq::modules::asam_cmp_data_sink_module::DataPacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::Endpoint;
+using daq::modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+
+namespace
+{
+
+struct CountingSubscriber : public ImplementationOf<IAsamCmpPacketsSubscriber>
+{
+    void receive(const std::shared_ptr<Packet>& packet) override
+    {
+        ++received;
+    }
+
+    void receive(const std::vector<std::shared_ptr<Packet>>& packets) override
+    {
+        received += packets.size();
+    }
+
+    size_t received{0};
+};
+
+Endpoint makeEndpoint(size_t ind)
+{
+    return {static_cast<uint16_t>(ind % 16), static_cast<uint32_t>(ind / 16 % 64), static_cast<uint8_t>(ind / 1024)};
+}
+
+// Every subscriber listens to its own endpoint, so publish() pays for the lookup among all of them
+void BM_DataPacketsPublisherSpread(benchmark::State& state)
+{
+    const size_t subscribersCount = state.range(0);
+
+    DataPacketsPublisher publisher;
+    std::vector<std::unique_ptr<CountingSubscriber>> subscribers;
+    subscribers.reserve(subscribersCount);
+    for (size_t i = 0; i < subscribersCount; ++i)
+    {
+        subscribers.push_back(std::make_unique<CountingSubscriber>());
+        publisher.subscribe(makeEndpoint(i), subscribers.back().get());
+    }
+
+    const Endpoint endpoint = makeEndpoint(subscribersCount / 2);
+    auto packet = std::make_shared<Packet>();
+
+    for (auto _ : state)
+        publisher.publish(endpoint, packet);
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// All subscribers share a single endpoint, so publish() pays for the fan-out
+void BM_DataPacketsPublisherFanOut(benchmark::State& state)
+{
+    const size_t subscribersCount = state.range(0);
+
+    DataPacketsPublisher publisher;
+    std::vector<std::unique_ptr<CountingSubscriber>> subscribers;
+    subscribers.reserve(subscribersCount);
+    for (size_t i = 0; i < subscribersCount; ++i)
+    {
+        subscribers.push_back(std::make_unique<CountingSubscriber>());
+        publisher.subscribe(makeEndpoint(0), subscribers.back().get());
+    }
+
+    auto packet = std::make_shared<Packet>();
+
+    for (auto _ : state)
+        publisher.publish(makeEndpoint(0), packet);
+
+    state.SetItemsProcessed(state.iterations() * subscribersCount);
+}
+
+}  // namespace
+
+BENCHMARK(BM_DataPacketsPublisherSpread)->Arg(10)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_DataPacketsPublisherFanOut)->Arg(10)->Arg(1000)->Arg(10000);
@@ -0,0 +1,134 @@
+#include <RawPacket.h>
+#include <asam_cmp/can_payload.h>
+#include <asam_cmp/encoder.h>
+#include <benchmark/benchmark.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp_data_sink/data_sink_module_fb.h>
+
+using namespace daq;
+using daq::asam_cmp_common_lib::EthernetPcppMock;
+using daq::asam_cmp_common_lib::PcppPacketReceivedCallbackType;
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace
+{
+
+constexpr uint16_t deviceId = 1;
+constexpr uint32_t interfaceId = 2;
+constexpr uint8_t streamId = 3;
+constexpr int canPayloadType = 1;
+constexpr size_t ethHeaderSize = 14;
+constexpr size_t sequenceCounterOffset = ethHeaderSize + 6;
+
+// Builds Ethernet frames carrying CMP data messages with the given number of aggregated CAN messages each
+std::vector<std::vector<uint8_t>> createFrames(size_t messagesPerFrame, size_t framesCount)
+{
+    ASAM::CMP::Encoder encoder;
+    encoder.setDeviceId(deviceId);
+    encoder.setStreamId(streamId);
+
+    std::array<uint8_t, 8> data;
+    std::iota(data.begin(), data.end(), uint8_t{0});
+
+    std::vector<ASAM::CMP::Packet> packets(messagesPerFrame * framesCount);
+    for (size_t i = 0; i < packets.size(); ++i)
+    {
+        ASAM::CMP::CanPayload payload;
+        payload.setData(data.data(), data.size());
+        payload.setId(static_cast<uint32_t>(i % 0x800));
+
+        packets[i].setInterfaceId(interfaceId);
+        packets[i].setPayload(payload);
+        packets[i].setTimestamp(i * 100000);
+    }
+
+    const ASAM::CMP::DataContext dataContext{64, 1500};
+    const std::array<uint8_t, ethHeaderSize> ethHeader{
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x50, 0x43, 0x11, 0x22, 0x33, 0x99, 0xFE};
+
+    // Each chunk fits into a single frame, so every frame aggregates exactly messagesPerFrame messages
+    std::vector<std::vector<uint8_t>> frames;
+    for (auto chunk = packets.begin(); chunk != packets.end(); chunk += messagesPerFrame)
+    {
+        for (auto& cmpFrame : encoder.encode(chunk, chunk + messagesPerFrame, dataContext))
+        {
+            auto& frame = frames.emplace_back(ethHeader.begin(), ethHeader.end());
+            frame.insert(frame.end(), cmpFrame.begin(), cmpFrame.end());
+        }
+    }
+
+    return frames;
+}
+
+void BM_DataSinkModuleFbOnPacketArrives(benchmark::State& state)
+{
+    auto ethernetWrapper = std::make_shared<NiceMock<EthernetPcppMock>>();
+
+    ListPtr<StringPtr> names{"name1"};
+    ListPtr<StringPtr> descriptions{"desc1"};
+    PcppPacketReceivedCallbackType packetReceivedCallback;
+
+    ON_CALL(*ethernetWrapper, startCapture(_))
+        .WillByDefault([&packetReceivedCallback](PcppPacketReceivedCallbackType callback) { packetReceivedCallback = callback; });
+    ON_CALL(*ethernetWrapper, setDevice(_)).WillByDefault(Return(true));
+    ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(names));
+    ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
+
+    auto logger = Logger();
+    auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr);
+    auto funcBlock = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::DataSinkModuleFb>(
+        context, nullptr, "id", ethernetWrapper);
+
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    auto captureFb = dataSinkFb.getFunctionBlocks().getItemAt(0);
+    captureFb.setPropertyValue("DeviceId", deviceId);
+    captureFb.getPropertyValue("AddInterface").execute();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    interfaceFb.setPropertyValue("InterfaceId", interfaceId);
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    interfaceFb.getPropertyValue("AddStream").execute();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    streamFb.setPropertyValue("StreamId", static_cast<Int>(streamId));
+
+    const size_t messagesPerFrame = state.range(0);
+    auto frames = createFrames(messagesPerFrame, 64);
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    timeval timestamp{};
+    timestamp.tv_sec = static_cast<decltype(timestamp.tv_sec)>(std::chrono::duration_cast<std::chrono::seconds>(now).count());
+
+    std::vector<std::unique_ptr<pcpp::RawPacket>> rawPackets;
+    for (auto& frame : frames)
+        rawPackets.push_back(
+            std::make_unique<pcpp::RawPacket>(frame.data(), static_cast<int>(frame.size()), timestamp, false, pcpp::LINKTYPE_ETHERNET));
+
+    // Keep the sequence counter contiguous so the sink sees an in-order stream rather than replayed duplicates
+    uint16_t sequenceCounter = 0;
+    size_t frameInd = 0;
+    for (auto _ : state)
+    {
+        auto& frame = frames[frameInd];
+        frame[sequenceCounterOffset] = static_cast<uint8_t>(sequenceCounter >> 8);
+        frame[sequenceCounterOffset + 1] = static_cast<uint8_t>(sequenceCounter);
+        ++sequenceCounter;
+
+        packetReceivedCallback(rawPackets[frameInd].get(), nullptr, nullptr);
+        frameInd = (frameInd + 1) % rawPackets.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * messagesPerFrame);
+}
+
+}  // namespace
+
+BENCHMARK(BM_DataSinkModuleFbOnPacketArrives)->Arg(1)->Arg(8)->Arg(32);
@@ -0,0 +1,113 @@
+#include <asam_cmp/analog_payload.h>
+#include <asam_cmp/can_fd_payload.h>
+#include <asam_cmp/can_payload.h>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <numeric>
+
+#include <asam_cmp_capture_module/encoder_bank.h>
+
+using ASAM::CMP::AnalogPayload;
+using ASAM::CMP::CanFdPayload;
+using ASAM::CMP::CanPayload;
+using ASAM::CMP::Packet;
+using daq::modules::asam_cmp_capture_module::EncoderBank;
+
+namespace
+{
+
+constexpr uint16_t deviceId = 1;
+constexpr uint32_t interfaceId = 2;
+constexpr uint8_t streamId = 3;
+const ASAM::CMP::DataContext dataContext{64, 1500};
+
+// Payload lengths cycle through the sizes seen on a typical bus: classic CAN frames of every DLC
+// and CAN FD frames of every valid DLC above 8 bytes
+constexpr std::array<uint8_t, 9> canLengths{0, 1, 2, 3, 4, 5, 6, 7, 8};
+constexpr std::array<uint8_t, 8> canFdLengths{8, 12, 16, 20, 24, 32, 48, 64};
+
+template <typename PayloadType, size_t N>
+std::vector<Packet> createCanPackets(size_t count, const std::array<uint8_t, N>& lengths)
+{
+    std::array<uint8_t, 64> data;
+    std::iota(data.begin(), data.end(), uint8_t{0});
+
+    std::vector<Packet> packets(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        PayloadType payload;
+        payload.setData(data.data(), lengths[i % lengths.size()]);
+        payload.setId(static_cast<uint32_t>(i % 0x800));
+
+        packets[i].setInterfaceId(interfaceId);
+        packets[i].setPayload(payload);
+        packets[i].setTimestamp(i * 100000);
+    }
+
+    return packets;
+}
+
+template <typename PayloadType, size_t N>
+void encodeCanPackets(benchmark::State& state, const std::array<uint8_t, N>& lengths)
+{
+    auto encoders = std::make_unique<EncoderBank>();
+    encoders->init(deviceId);
+    const auto packets = createCanPackets<PayloadType>(state.range(0), lengths);
+
+    for (auto _ : state)
+    {
+        auto frames = encoders->encode(streamId, packets.begin(), packets.end(), dataContext);
+        benchmark::DoNotOptimize(frames);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_EncoderBankCan(benchmark::State& state)
+{
+    encodeCanPackets<CanPayload>(state, canLengths);
+}
+
+void BM_EncoderBankCanFd(benchmark::State& state)
+{
+    encodeCanPackets<CanFdPayload>(state, canFdLengths);
+}
+
+template <typename SampleType>
+void BM_EncoderBankAnalog(benchmark::State& state)
+{
+    const size_t sampleCount = state.range(0);
+    std::vector<SampleType> data(sampleCount);
+    std::iota(data.begin(), data.end(), SampleType{0});
+
+    AnalogPayload payload;
+    payload.setData(reinterpret_cast<uint8_t*>(data.data()), data.size() * sizeof(SampleType));
+    payload.setSampleDt(AnalogPayload::SampleDtFromType<SampleType>::sampleDtType);
+    payload.setUnit(AnalogPayload::Unit::ampere);
+    payload.setSampleInterval(20e-6f);
+    payload.setSampleOffset(0.f);
+    payload.setSampleScalar(1e-3f);
+
+    Packet packet;
+    packet.setInterfaceId(interfaceId);
+    packet.setPayload(payload);
+
+    auto encoders = std::make_unique<EncoderBank>();
+    encoders->init(deviceId);
+
+    for (auto _ : state)
+    {
+        auto frames = encoders->encode(streamId, packet, dataContext);
+        benchmark::DoNotOptimize(frames);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sampleCount);
+}
+
+}  // namespace
+
+BENCHMARK(BM_EncoderBankCan)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(BM_EncoderBankCanFd)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_EncoderBankAnalog, int16_t)->Arg(80)->Arg(700);
+BENCHMARK_TEMPLATE(BM_EncoderBankAnalog, int32_t)->Arg(80)->Arg(350);
@@ -0,0 +1,156 @@
+#include <asam_cmp/analog_payload.h>
+#include <asam_cmp/can_payload.h>
+#include <benchmark/benchmark.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+#include <asam_cmp_data_sink/asam_cmp_packets_subscriber.h>
+#include <asam_cmp_data_sink/capture_fb.h>
+#include <asam_cmp_data_sink/capture_packets_publisher.h>
+#include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
+
+using namespace daq;
+using ASAM::CMP::AnalogPayload;
+using ASAM::CMP::CanPayload;
+using ASAM::CMP::Packet;
+using daq::modules::asam_cmp_data_sink_module::CapturePacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::DataPacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+using daq::modules::asam_cmp_data_sink_module::LatencyProbeTracker;
+using daq::modules::asam_cmp_data_sink_module::SequenceTracker;
+
+namespace
+{
+
+constexpr uint16_t deviceId = 0;
+constexpr uint32_t interfaceId = 1;
+constexpr uint8_t streamId = 2;
+constexpr int canPayloadType = 1;
+constexpr int analogPayloadType = 3;
+
+uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+class StreamFixture
+{
+public:
+    explicit StreamFixture(int payloadType)
+    {
+        auto logger = Logger();
+        captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::CaptureFb>(
+            Context(Scheduler(logger), logger, TypeManager(), nullptr),
+            nullptr,
+            "capture_module_0",
+            publisher,
+            capturePacketsPublisher,
+            sequenceTracker,
+            latencyProbeTracker);
+
+        captureFb.getPropertyValue("AddInterface").execute();
+        interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+        interfaceFb.getPropertyValue("AddStream").execute();
+        streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+        captureFb.setPropertyValue("DeviceId", deviceId);
+        interfaceFb.setPropertyValue("InterfaceId", interfaceId);
+        interfaceFb.setPropertyValue("PayloadType", payloadType);
+        streamFb.setPropertyValue("StreamId", static_cast<Int>(streamId));
+
+        subscriber = streamFb.as<IAsamCmpPacketsSubscriber>(true);
+    }
+
+public:
+    DataPacketsPublisher publisher;
+    CapturePacketsPublisher capturePacketsPublisher;
+    SequenceTracker sequenceTracker;
+    LatencyProbeTracker latencyProbeTracker;
+    FunctionBlockPtr captureFb;
+    FunctionBlockPtr interfaceFb;
+    FunctionBlockPtr streamFb;
+    IAsamCmpPacketsSubscriber* subscriber;
+};
+
+std::shared_ptr<Packet> createPacket(const ASAM::CMP::Payload& payload, uint64_t timestamp)
+{
+    auto packet = std::make_shared<Packet>();
+    packet->setPayload(payload);
+    packet->setTimestamp(timestamp);
+    packet->setDeviceId(deviceId);
+    packet->setInterfaceId(interfaceId);
+    packet->setStreamId(streamId);
+
+    return packet;
+}
+
+// CAN messages go through processAsyncData, batched the same way the data sink module publishes aggregated frames
+void BM_StreamFbCan(benchmark::State& state)
+{
+    StreamFixture fixture(canPayloadType);
+
+    std::array<uint8_t, 8> data;
+    std::iota(data.begin(), data.end(), uint8_t{0});
+
+    const size_t messagesCount = state.range(0);
+    const auto timestamp = now();
+    std::vector<std::shared_ptr<Packet>> packets;
+    packets.reserve(messagesCount);
+    for (size_t i = 0; i < messagesCount; ++i)
+    {
+        CanPayload payload;
+        payload.setData(data.data(), static_cast<uint8_t>(i % (data.size() + 1)));
+        payload.setId(static_cast<uint32_t>(i % 0x800));
+        packets.push_back(createPacket(payload, timestamp + i * 100000));
+    }
+
+    for (auto _ : state)
+        fixture.subscriber->receive(packets);
+
+    state.SetItemsProcessed(state.iterations() * messagesCount);
+}
+
+// Analog messages go through processSyncData; timestamps advance so the output signal stays contiguous
+template <typename SampleType>
+void BM_StreamFbAnalog(benchmark::State& state)
+{
+    constexpr float sampleInterval = 20e-6f;
+    constexpr uint64_t deltaT = static_cast<uint64_t>(1e9 * sampleInterval);
+
+    StreamFixture fixture(analogPayloadType);
+
+    const size_t sampleCount = state.range(0);
+    std::vector<SampleType> data(sampleCount);
+    std::iota(data.begin(), data.end(), SampleType{0});
+
+    AnalogPayload payload;
+    payload.setData(reinterpret_cast<uint8_t*>(data.data()), data.size() * sizeof(SampleType));
+    payload.setSampleDt(AnalogPayload::SampleDtFromType<SampleType>::sampleDtType);
+    payload.setUnit(AnalogPayload::Unit::kilogram);
+    payload.setSampleInterval(sampleInterval);
+    payload.setSampleOffset(50);
+    payload.setSampleScalar(0.3f);
+
+    auto timestamp = now();
+    auto packet = createPacket(payload, timestamp);
+
+    for (auto _ : state)
+    {
+        packet->setTimestamp(timestamp);
+        fixture.subscriber->receive(packet);
+        timestamp += sampleCount * deltaT;
+    }
+
+    state.SetItemsProcessed(state.iterations() * sampleCount);
+}
+
+}  // namespace
+
+BENCHMARK(BM_StreamFbCan)->Arg(1)->Arg(32)->Arg(256);
+BENCHMARK_TEMPLATE(BM_StreamFbAnalog, int16_t)->Arg(80)->Arg(700);
+BENCHMARK_TEMPLATE(BM_StreamFbAnalog, int32_t)->Arg(80)->Arg(350);
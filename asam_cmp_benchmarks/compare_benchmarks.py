@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON reports and fails when a benchmark got slower than the threshold allows."""
+
+import argparse
+import json
+import sys
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    with open(path) as file:
+        report = json.load(file)
+
+    results = {}
+    for benchmark in report["benchmarks"]:
+        # With repetitions only the median is compared, it is the most stable aggregate
+        if benchmark.get("run_type") == "aggregate" and benchmark.get("aggregate_name") != "median":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        if benchmark.get("run_type") == "iteration" and name in results:
+            continue
+        results[name] = benchmark[metric] * TIME_UNITS[benchmark.get("time_unit", "ns")]
+
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="baseline JSON report")
+    parser.add_argument("current", help="current JSON report")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in percent (default: 10)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="cpu_time", help="compared time (default: cpu_time)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    regressions = []
+    print(f"{'Benchmark':<60} {'Baseline, ns':>14} {'Current, ns':>14} {'Change':>9}")
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in baseline or name not in current:
+            state = "added" if name in current else "removed"
+            print(f"{name:<60} {state:>39}")
+            continue
+
+        change = (current[name] - baseline[name]) / baseline[name] * 100.0
+        marker = ""
+        if change > args.threshold:
+            regressions.append(name)
+            marker = "  REGRESSION"
+        print(f"{name:<60} {baseline[name]:>14.1f} {current[name]:>14.1f} {change:>+8.1f}%{marker}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) are more than {args.threshold}% slower than the baseline")
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
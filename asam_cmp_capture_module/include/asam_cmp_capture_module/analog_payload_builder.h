@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <asam_cmp/analog_payload.h>
+#include <opendaq/data_packet_ptr.h>
+#include <opendaq/sample_type_traits.h>
+#include <cmath>
+
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_common_lib/unit_converter.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+template <SampleType SrcType>
+void createAnalogPayloadWithInternalScaling(ASAM::CMP::AnalogPayload& payload,
+                                            const daq::DataPacketPtr& packet,
+                                            Float analogDataScale,
+                                            Float analogDataOffset,
+                                            Float analogDataDeltaTime)
+{
+    payload.setSampleInterval(analogDataDeltaTime);
+
+    using SourceType = typename SampleTypeToType<SrcType>::Type;
+    auto* rawData = reinterpret_cast<SourceType*>(packet.getRawData());
+    const size_t sampleCount = packet.getSampleCount();
+
+    uint8_t unitId = asam_cmp_common_lib::Units::getIdBySymbol(packet.getDataDescriptor().getUnit().getSymbol().toView());
+    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(unitId));
+    payload.setSampleDt(ASAM::CMP::AnalogPayload::SampleDt::aInt32);
+    payload.setSampleScalar(analogDataScale);
+    payload.setSampleOffset(analogDataOffset);
+
+    std::vector<int32_t> scaledData(sampleCount);
+    for (int i = 0; i < sampleCount; ++i)
+    {
+        scaledData[i] = std::round((rawData[i] - analogDataOffset) / analogDataScale);
+    }
+
+    payload.setData(reinterpret_cast<uint8_t*>(scaledData.data()), sampleCount * sizeof(int32_t));
+}
+
+void createAnalogPayload(ASAM::CMP::AnalogPayload& payload,
+                         const DataPacketPtr& packet,
+                         const DataDescriptorPtr& inputDataDescriptor,
+                         Float analogDataScale,
+                         Float analogDataOffset,
+                         Float analogDataDeltaTime,
+                         Int analogDataSampleDt);
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
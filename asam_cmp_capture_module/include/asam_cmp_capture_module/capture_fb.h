@@ -18,12 +18,13 @@
 #include <asam_cmp_common_lib/id_manager.h>
 #include <asam_cmp/device_status.h>
 #include <asam_cmp_capture_module/encoder_bank.h>
+#include <asam_cmp_capture_module/status_timer.h>
 #include <asam_cmp_capture_module/common.h>
 #include <asam_cmp_common_lib/capture_common_fb.h>
 #include <asam_cmp/capture_module_payload.h>
 
-#include <thread>
-#include <condition_variable>
+#include <chrono>
+#include <memory>
 
 namespace daq::asam_cmp_common_lib
 {
@@ -36,6 +37,10 @@ struct CaptureFbInit
 {
     const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper;
     const StringPtr& selectedDeviceName;
+    // Set by a capture module FB that has several capture FBs, a capture FB without them runs its own timer
+    asam_cmp_common_lib::DeviceIdManagerPtr deviceIdManager{nullptr};
+    std::shared_ptr<StatusTimer> statusTimer{};
+    uint16_t deviceId{0};
 };
 
 class CaptureFb final : public daq::asam_cmp_common_lib::CaptureCommonFb
@@ -48,17 +53,21 @@ public:
 
 private:
     void initProperties();
+    void initLatencyProbeProperties();
+    void initTopologyProperties();
+    void configureTopology(const ListPtr<IBaseObject>& topology);
     void initEncoders();
     void initStatusPacket();
     void updateCaptureData();
+    void requestStatusBurst();
 
     void addInterfaceInternal() override;
     void removeInterfaceInternal(size_t nInd) override;
+    void updateDeviceIdInternal() override;
     void propertyChanged() override;
 
-    void statusLoop();
-    void startStatusLoop();
-    void stopStatusLoop();
+    StatusTimer::Clock::time_point sendPeriodicMessages(StatusTimer::Clock::time_point now);
+    void sendLatencyProbe();
     ASAM::CMP::DataContext createEncoderDataContext() const;
 
 private:
@@ -67,13 +76,22 @@ private:
     ASAM::CMP::Packet captureStatusPacket;
     ASAM::CMP::DeviceStatus captureStatus;
 
-    std::thread statusThread;
     std::mutex statusSync;
-    std::condition_variable cv;
+    std::shared_ptr<StatusTimer> statusTimer;
+    size_t statusTimerId{0};
     const size_t sendingSyncLoopTime{1000};
-    bool stopStatusSending;
+    // A new topology is repeated a few times at a short period, so the sink doesn't wait for the regular period if one is lost
+    const size_t statusBurstCount{3};
+    const std::chrono::milliseconds statusBurstPeriod{100};
+    size_t statusBurstLeft{0};
+    StatusTimer::Clock::time_point nextStatusTime;
+    bool latencyProbeEnabled{false};
+    std::chrono::milliseconds latencyProbePeriod{100};
+    StatusTimer::Clock::time_point nextLatencyProbeTime;
+    uint16_t latencyProbeCounter{0};
     std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
     const StringPtr& selectedEthernetDeviceName;
+    asam_cmp_common_lib::DeviceIdManagerPtr deviceIdManager;
 };
 
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -17,6 +17,8 @@
 #pragma once
 #include <asam_cmp/encoder.h>
 #include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_capture_module/status_timer.h>
+#include <asam_cmp_common_lib/id_manager.h>
 #include <opendaq/context_factory.h>
 #include <opendaq/function_block_impl.h>
 #include <asam_cmp_common_lib/network_manager_fb.h>
@@ -33,8 +35,18 @@ public:
     static FunctionBlockPtr create(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
 
 private:
+    void initProperties();
     void createFbs();
+    void addCapture();
+    void removeCapture(size_t nInd);
+    void addCaptureInternal(const StringPtr& fbId, uint16_t deviceId);
     void networkAdapterChangedInternal() override;
+
+private:
+    // Shared by all capture FBs of the module, frames of all of them go through the common ethernet wrapper
+    std::shared_ptr<StatusTimer> statusTimer;
+    asam_cmp_common_lib::DeviceIdManager deviceIdManager;
+    size_t createdCaptures{0};
 };
 
 
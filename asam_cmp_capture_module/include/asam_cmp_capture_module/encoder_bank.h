@@ -18,6 +18,7 @@
 #include <asam_cmp_capture_module/common.h>
 #include <asam_cmp/packet.h>
 #include <asam_cmp/encoder.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
 #include <array>
 #include <mutex>
 
@@ -34,11 +35,18 @@ public:
     template <typename ForwardIterator>
     std::vector<std::vector<uint8_t>> encode(uint8_t encoderInd, ForwardIterator begin, ForwardIterator end, const ASAM::CMP::DataContext& dataContext);
     std::vector<std::vector<uint8_t>> encode(uint8_t encoderInd, const ASAM::CMP::Packet& packet, const ASAM::CMP::DataContext& dataContext);
+    // Status messages have their own sequence counter, so they don't step the counter of the data stream
+    std::vector<std::vector<uint8_t>> encodeStatus(const ASAM::CMP::Packet& packet, const ASAM::CMP::DataContext& dataContext);
+
+public:
+    static constexpr uint8_t statusStreamId = 1;
 
 private:
     static constexpr size_t encodersCount = 256;
     std::array<ASAM::CMP::Encoder, encodersCount> encoders;
     std::array<std::mutex, encodersCount> encoderSyncs;
+    ASAM::CMP::Encoder statusEncoder;
+    std::mutex statusEncoderSync;
 };
 
 template <typename ForwardIterator>
@@ -47,6 +55,7 @@ std::vector<std::vector<uint8_t>> EncoderBank::encode(uint8_t encoderInd,
                                          ForwardIterator end,
                                          const ASAM::CMP::DataContext& dataContext)
 {
+    ASAM_CMP_LATENCY_SCOPE(encode);
     std::scoped_lock lock(encoderSyncs[encoderInd]);
     return encoders[encoderInd].encode(begin, end, dataContext);
 }
@@ -17,6 +17,7 @@
 #pragma once
 #include <asam_cmp/encoder.h>
 #include <asam_cmp/device_status.h>
+#include <functional>
 #include <asam_cmp_capture_module/common.h>
 #include <asam_cmp_common_lib/id_manager.h>
 #include <asam_cmp_capture_module/encoder_bank.h>
@@ -32,6 +33,14 @@ namespace daq::asam_cmp_common_lib
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
+// Interface with its streams created in one step by the ConfigureTopology procedure of the Capture FB
+struct InterfaceTopology
+{
+    uint32_t interfaceId;
+    Int payloadType;
+    std::vector<uint8_t> streamIds;
+};
+
 struct InterfaceFbInit
 {
     const EncoderBankPtr& encoders;
@@ -40,6 +49,9 @@ struct InterfaceFbInit
     const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper;
     const bool& allowJumboFrames;
     const StringPtr& selectedDeviceName;
+    // Called under statusSync whenever the interface status changes
+    const std::function<void()>& statusChanged;
+    const InterfaceTopology* topology{nullptr};
 };
 
 class InterfaceFb final : public asam_cmp_common_lib::InterfaceCommonFb
@@ -55,6 +67,8 @@ public:
 
 private:
     void initProperties();
+    void applyTopology(const InterfaceTopology& topology);
+    void addStreamWithId(uint8_t streamId);
     void addStreamInternal() override;
     void removeStreamInternal(size_t nInd) override;
     void initStatusPacket();
@@ -76,6 +90,7 @@ private:
     const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper;
     const bool& allowJumboFrames;
     const StringPtr& selectedDeviceName;
+    std::function<void()> statusChanged;
 };
 
 
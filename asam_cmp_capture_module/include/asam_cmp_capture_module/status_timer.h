@@ -0,0 +1,74 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// One thread serving the periodic messages of all capture FBs of a capture module
+class StatusTimer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    // Sends what is due at the given time and returns the time of the next call
+    using Callback = std::function<Clock::time_point(Clock::time_point now)>;
+
+    StatusTimer() = default;
+    ~StatusTimer();
+
+    StatusTimer(const StatusTimer&) = delete;
+    StatusTimer& operator=(const StatusTimer&) = delete;
+
+    size_t add(Callback callback, Clock::time_point firstTime);
+    // After return the callback is not running and won't be called again
+    void remove(size_t id);
+    // Calls every callback again, e.g. after a client has changed its period.
+    // Unlike add and remove it may be called under a lock that the callbacks take
+    void wake();
+
+private:
+    struct Client
+    {
+        Callback callback;
+        Clock::time_point nextTime;
+    };
+
+    void loop();
+
+    Clock::time_point callClients(bool callAll);
+
+private:
+    // Guards the clients, callbacks run under it
+    std::mutex clientsSync;
+    std::map<size_t, Client> clients;
+    size_t nextId{0};
+
+    // Guards the wait state only, so waking never waits for a running callback
+    std::mutex sync;
+    std::condition_variable cv;
+    bool wakeRequested{false};
+    bool stop{false};
+    std::thread thread;
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
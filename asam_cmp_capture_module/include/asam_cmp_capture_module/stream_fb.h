@@ -70,6 +70,7 @@ private:
     void onAnalogSignalDisconnected();
 
     void onPacketReceived(const InputPortPtr& port) override;
+    PacketPtr dequeuePacket(const ConnectionPtr& connection);
     void onDisconnected(const InputPortPtr& port) override;
     void processSignalDescriptorChanged(DataDescriptorPtr inputDataDescriptor, DataDescriptorPtr inputDomainDataDescriptor);
     void configure();
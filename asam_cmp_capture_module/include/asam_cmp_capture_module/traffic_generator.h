@@ -0,0 +1,128 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <asam_cmp/packet.h>
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_capture_module/encoder_bank.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+enum class GeneratorPayloadType
+{
+    can,
+    canFd,
+    analog,
+    mixed
+};
+
+enum class CanIdDistribution
+{
+    sequential,
+    uniform,
+    zipf
+};
+
+struct TrafficGeneratorConfig
+{
+    uint16_t firstDeviceId{1000};
+    uint16_t deviceCount{1};
+    uint32_t interfacesPerDevice{1};
+    uint32_t streamsPerInterface{1};
+    GeneratorPayloadType payloadType{GeneratorPayloadType::can};
+    double messageRate{1000.0};
+    // Relative spread of the per-stream rates around messageRate: the streams get rates evenly distributed over
+    // [messageRate * (1 - spread), messageRate * (1 + spread)], so the mean rate stays messageRate
+    double messageRateSpread{0.0};
+    CanIdDistribution canIdDistribution{CanIdDistribution::sequential};
+    uint32_t canIdCount{64};
+    uint8_t canDataLength{8};
+    uint8_t canFdDataLength{64};
+    uint16_t analogSamplesPerMessage{80};
+    std::chrono::milliseconds burstPeriod{0};
+    std::chrono::milliseconds statusPeriod{1000};
+};
+
+// Emits CMP data and status messages for a set of virtual capture modules. Interfaces are numbered from 0 and
+// streams from 1 within every device; with the mixed payload type interfaces cycle through CAN, CAN FD and analog.
+class TrafficGenerator
+{
+public:
+    TrafficGenerator(const TrafficGeneratorConfig& config, const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper);
+
+    // Sends every data message due at `now` (ns since the epoch) and the status messages when the status period expired.
+    // With a burst period, messages are held back and sent together once per period.
+    void step(uint64_t now);
+
+    uint64_t getSentFrames() const;
+    uint64_t getSentMessages() const;
+
+    static GeneratorPayloadType getInterfacePayloadType(GeneratorPayloadType payloadType, uint32_t interfaceId);
+
+public:
+    // Catch-up limit after a stall, in seconds of traffic
+    static constexpr double maxBacklog = 1.0;
+
+private:
+    struct Stream
+    {
+        size_t deviceInd;
+        uint32_t interfaceId;
+        uint8_t streamId;
+        GeneratorPayloadType payloadType;
+        double rate;
+        uint64_t sent{0};
+        uint32_t canIdCounter{0};
+    };
+
+    double getStreamRate(size_t streamInd, size_t streamCount) const;
+    void createStatusPackets();
+    void sendStatus();
+    void sendData(Stream& stream, size_t count, uint64_t now);
+    void sendFrames(const std::vector<std::vector<uint8_t>>& frames);
+    uint32_t getNextCanId(Stream& stream);
+
+private:
+    const TrafficGeneratorConfig config;
+    const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
+    const ASAM::CMP::DataContext dataContext{64, 1500};
+
+    std::vector<std::unique_ptr<EncoderBank>> encoders;
+    std::vector<Stream> streams;
+    std::vector<std::vector<ASAM::CMP::Packet>> statusPackets;
+    std::vector<ASAM::CMP::Packet> dataPackets;
+    std::vector<uint8_t> canData;
+    std::vector<int16_t> analogData;
+
+    std::mt19937 random;
+    std::uniform_int_distribution<uint32_t> uniformCanIds;
+    std::discrete_distribution<uint32_t> zipfCanIds;
+
+    uint64_t startTime{0};
+    uint64_t nextBurstTime{0};
+    uint64_t nextStatusTime{0};
+
+    std::atomic<uint64_t> sentFrames{0};
+    std::atomic<uint64_t> sentMessages{0};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
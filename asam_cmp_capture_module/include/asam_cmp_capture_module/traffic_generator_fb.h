@@ -0,0 +1,68 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_capture_module/traffic_generator.h>
+#include <asam_cmp_common_lib/network_manager_fb.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+class TrafficGeneratorFb final : public asam_cmp_common_lib::NetworkManagerFb
+{
+public:
+    explicit TrafficGeneratorFb(const ContextPtr& ctx,
+                                const ComponentPtr& parent,
+                                const StringPtr& localId,
+                                const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper);
+    ~TrafficGeneratorFb() override;
+
+    static FunctionBlockTypePtr CreateType();
+    static FunctionBlockPtr create(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+
+private:
+    void initProperties();
+    void addConfigProperty(const PropertyPtr& prop);
+    void addCounterProperties();
+    void readConfig();
+    void restartGenerator();
+    void startGeneratorLoop();
+    void stopGeneratorLoop();
+    void generatorLoop();
+    void networkAdapterChangedInternal() override;
+
+private:
+    TrafficGeneratorConfig config;
+    std::unique_ptr<TrafficGenerator> generator;
+    uint64_t previousSentFrames{0};
+    uint64_t previousSentMessages{0};
+    // Totals published by the generator thread so that the counter properties are read without generatorSync
+    std::atomic<uint64_t> sentFrames{0};
+    std::atomic<uint64_t> sentMessages{0};
+
+    std::thread generatorThread;
+    std::mutex generatorSync;
+    std::condition_variable cv;
+    bool stopGenerator{true};
+    const std::chrono::milliseconds generatorLoopTime{1};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,30 @@
+#include <asam_cmp_capture_module/analog_payload_builder.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+void createAnalogPayload(ASAM::CMP::AnalogPayload& payload,
+                         const DataPacketPtr& packet,
+                         const DataDescriptorPtr& inputDataDescriptor,
+                         Float analogDataScale,
+                         Float analogDataOffset,
+                         Float analogDataDeltaTime,
+                         Int analogDataSampleDt)
+{
+    payload.setSampleInterval(analogDataDeltaTime);
+
+    auto* rawData = reinterpret_cast<uint8_t*>(packet.getRawData());
+    const size_t sampleCount = packet.getSampleCount();
+    const auto inputSampleType = inputDataDescriptor.getPostScaling().assigned() ? inputDataDescriptor.getPostScaling().getInputSampleType()
+                                                                                 : inputDataDescriptor.getSampleType();
+    const size_t sampleSize = inputSampleType == SampleType::Int16 ? 2 : 4;
+
+    uint8_t unitId = asam_cmp_common_lib::Units::getIdBySymbol(packet.getDataDescriptor().getUnit().getSymbol().toView());
+    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(unitId));
+    payload.setSampleDt(analogDataSampleDt == 16 ? ASAM::CMP::AnalogPayload::SampleDt::aInt16 : ASAM::CMP::AnalogPayload::SampleDt::aInt32);
+    payload.setSampleScalar(analogDataScale);
+    payload.setSampleOffset(analogDataOffset);
+
+    payload.setData(rawData, sampleCount * sampleSize);
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -2,28 +2,93 @@
 #include <asam_cmp_capture_module/interface_fb.h>
 #include <coreobjects/callable_info_factory.h>
 #include <coreobjects/argument_info_factory.h>
+#include <coreobjects/unit_factory.h>
+#include <coretypes/dictobject_factory.h>
 #include <set>
 #include <fmt/format.h>
 #include <asam_cmp/cmp_header.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_common_lib/latency_probe.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
+namespace
+{
+    Int getTopologyValue(const DictPtr<IString, IBaseObject>& description, const char* key, Int defaultValue, Int maxValue)
+    {
+        if (!description.hasKey(key))
+            return defaultValue;
+
+        const Int value = description.get(key);
+        if (value < 0 || value > maxValue)
+            throw InvalidParameterException(fmt::format("Topology {} {} is out of range", key, value));
+        return value;
+    }
+
+    std::vector<InterfaceTopology> parseTopology(const ListPtr<IBaseObject>& topology)
+    {
+        std::vector<InterfaceTopology> interfaces;
+        std::set<uint32_t> interfaceIds;
+        for (const DictPtr<IString, IBaseObject> description : topology)
+        {
+            if (!description.hasKey("InterfaceId"))
+                throw InvalidParameterException("Topology interface has no InterfaceId");
+
+            InterfaceTopology& interfaceTopology = interfaces.emplace_back();
+            interfaceTopology.interfaceId =
+                static_cast<uint32_t>(getTopologyValue(description, "InterfaceId", 0, std::numeric_limits<uint32_t>::max()));
+            interfaceTopology.payloadType = getTopologyValue(description, "PayloadType", 0, 3);
+            if (!interfaceIds.insert(interfaceTopology.interfaceId).second)
+                throw InvalidParameterException(fmt::format("Topology interface id {} is duplicated", interfaceTopology.interfaceId));
+
+            if (description.hasKey("StreamIds"))
+            {
+                std::set<uint8_t> streamIds;
+                for (const Int streamId : ListPtr<IBaseObject>(description.get("StreamIds")))
+                {
+                    if (streamId < 0 || streamId > std::numeric_limits<uint8_t>::max() || !streamIds.insert(static_cast<uint8_t>(streamId)).second)
+                        throw InvalidParameterException(fmt::format("Topology stream id {} is invalid or duplicated", streamId));
+                }
+                interfaceTopology.streamIds.assign(streamIds.begin(), streamIds.end());
+            }
+            else
+            {
+                const auto streamCount = getTopologyValue(description, "StreamCount", 0, std::numeric_limits<uint8_t>::max());
+                for (Int streamId = 1; streamId <= streamCount; ++streamId)
+                    interfaceTopology.streamIds.push_back(static_cast<uint8_t>(streamId));
+            }
+        }
+
+        return interfaces;
+    }
+}
+
 CaptureFb::CaptureFb(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId, const CaptureFbInit& init)
     : asam_cmp_common_lib::CaptureCommonFb(ctx, parent, localId)
     , ethernetWrapper(init.ethernetWrapper)
     , selectedEthernetDeviceName(init.selectedDeviceName)
+    , deviceIdManager(init.deviceIdManager)
+    , statusTimer(init.statusTimer ? init.statusTimer : std::make_shared<StatusTimer>())
     , allowJumboFrames(false)
 {
     initProperties();
+    if (init.deviceId != deviceId)
+    {
+        deviceId = init.deviceId;
+        setPropertyValueInternal(
+            String("DeviceId").asPtr<IString>(true), BaseObjectPtr(static_cast<Int>(deviceId)).asPtr<IBaseObject>(true), false, false, false);
+    }
     initEncoders();
     initStatusPacket();
-    startStatusLoop();
+
+    // initStatusPacket has scheduled the startup status burst
+    statusTimerId = statusTimer->add([this](StatusTimer::Clock::time_point now) { return sendPeriodicMessages(now); }, nextStatusTime);
 }
 
 CaptureFb::~CaptureFb()
 {
-    stopStatusLoop();
+    statusTimer->remove(statusTimerId);
 }
 
 void CaptureFb::initProperties()
@@ -37,6 +102,82 @@ void CaptureFb::initProperties()
     setPropertyValueInternal(String("HardwareVersion").asPtr<IString>(true), hardwareVersion, false, false, false);
     softwareVersion = "DefaultSoftwareVersion";
     setPropertyValueInternal(String("SoftwareVersion").asPtr<IString>(true), softwareVersion, false, false, false);
+
+    initLatencyProbeProperties();
+    initTopologyProperties();
+}
+
+void CaptureFb::initTopologyProperties()
+{
+    StringPtr propName = "ConfigureTopology";
+    objPtr.addProperty(
+        FunctionPropertyBuilder(propName, ProcedureInfo(List<IArgumentInfo>(ArgumentInfo("topology", ctList)))).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(
+        propName, Procedure([this](ListPtr<IBaseObject> topology) { configureTopology(topology); }));
+}
+
+void CaptureFb::configureTopology(const ListPtr<IBaseObject>& topology)
+{
+    // Validated completely before the current topology is touched
+    const auto interfaces = parseTopology(topology);
+
+    {
+        std::scoped_lock lock(sync, statusSync);
+        if (isUpdating)
+            throw std::runtime_error("Configuring topology is disabled during update");
+
+        const auto currentInterfaces = functionBlocks.getItems();
+        for (size_t i = currentInterfaces.getCount(); i-- > 0;)
+        {
+            int id = currentInterfaces.getItemAt(i).getPropertyValue("InterfaceId");
+            captureStatus.removeInterfaceById(id);
+            asam_cmp_common_lib::CaptureCommonFb::removeInterfaceInternal(i);
+        }
+
+        for (const auto& interfaceTopology : interfaces)
+        {
+            InterfaceFbInit init{&encoders,
+                                 captureStatus,
+                                 statusSync,
+                                 ethernetWrapper,
+                                 allowJumboFrames,
+                                 selectedEthernetDeviceName,
+                                 [this]() { requestStatusBurst(); },
+                                 &interfaceTopology};
+            addInterfaceWithParams<InterfaceFb>(interfaceTopology.interfaceId, init);
+        }
+
+        // The consolidated status goes out right away instead of after the next status period
+        requestStatusBurst();
+    }
+}
+
+void CaptureFb::initLatencyProbeProperties()
+{
+    StringPtr propName = "LatencyProbe";
+    objPtr.addProperty(BoolProperty(propName, False));
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        {
+            std::scoped_lock lock(statusSync);
+            latencyProbeEnabled = args.getValue();
+            nextLatencyProbeTime = StatusTimer::Clock::now();
+        }
+        statusTimer->wake();
+    };
+
+    propName = "LatencyProbePeriod";
+    objPtr.addProperty(
+        IntPropertyBuilder(propName, latencyProbePeriod.count()).setMinValue(1).setMaxValue(60000).setUnit(Unit("ms")).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        {
+            std::scoped_lock lock(statusSync);
+            latencyProbePeriod = std::chrono::milliseconds(static_cast<Int>(args.getValue()));
+            nextLatencyProbeTime = StatusTimer::Clock::now();
+        }
+        statusTimer->wake();
+    };
 }
 
 void CaptureFb::propertyChanged()
@@ -62,6 +203,15 @@ void CaptureFb::updateCaptureData()
         );
 
     captureStatus.update(captureStatusPacket);
+    requestStatusBurst();
+}
+
+// Must be called under statusSync
+void CaptureFb::requestStatusBurst()
+{
+    statusBurstLeft = statusBurstCount;
+    nextStatusTime = StatusTimer::Clock::now();
+    statusTimer->wake();
 }
 
 void CaptureFb::initEncoders()
@@ -80,7 +230,8 @@ void CaptureFb::addInterfaceInternal(){
     std::scoped_lock lock(statusSync);
 
     auto newId = interfaceIdManager.getFirstUnusedId();
-    InterfaceFbInit init{&encoders, captureStatus, statusSync, ethernetWrapper, allowJumboFrames, selectedEthernetDeviceName};
+    InterfaceFbInit init{
+        &encoders, captureStatus, statusSync, ethernetWrapper, allowJumboFrames, selectedEthernetDeviceName, [this]() { requestStatusBurst(); }};
     addInterfaceWithParams<InterfaceFb>(newId, init);
 }
 
@@ -91,6 +242,7 @@ void CaptureFb::removeInterfaceInternal(size_t nInd)
     int id = functionBlocks.getItems().getItemAt(nInd).getPropertyValue("InterfaceId");
     captureStatus.removeInterfaceById(id);
     asam_cmp_common_lib::CaptureCommonFb::removeInterfaceInternal(nInd);
+    requestStatusBurst();
 }
 
 ASAM::CMP::DataContext CaptureFb::createEncoderDataContext() const
@@ -99,52 +251,68 @@ ASAM::CMP::DataContext CaptureFb::createEncoderDataContext() const
     return {64, 1500};
 }
 
-void CaptureFb::statusLoop()
+void CaptureFb::updateDeviceIdInternal()
 {
-    auto encoderContext = createEncoderDataContext();
-    std::unique_lock<std::mutex> lock(statusSync);
-    while (!stopStatusSending)
+    Int newId = objPtr.getPropertyValue("DeviceId");
+    if (deviceIdManager == nullptr || newId == deviceId)
     {
-        cv.wait_for(lock, std::chrono::milliseconds(sendingSyncLoopTime));
-        if (!stopStatusSending)
-        {
-            auto encodeAndSend = [&](const ASAM::CMP::Packet& packet) {
-                auto encodedData = encoders.encode(1, packet, encoderContext);
-                for (const auto& e : encodedData)
-                    ethernetWrapper->sendPacket(e);
-            };
+        asam_cmp_common_lib::CaptureCommonFb::updateDeviceIdInternal();
+        return;
+    }
+
+    if (deviceIdManager->isValidId(newId))
+    {
+        deviceIdManager->removeId(deviceId);
+        asam_cmp_common_lib::CaptureCommonFb::updateDeviceIdInternal();
+        deviceIdManager->addId(deviceId);
+    }
+    else
+    {
+        setPropertyValueInternal(
+            String("DeviceId").asPtr<IString>(true), BaseObjectPtr(static_cast<Int>(deviceId)).asPtr<IBaseObject>(true), false, false, false);
+    }
+}
+
+StatusTimer::Clock::time_point CaptureFb::sendPeriodicMessages(StatusTimer::Clock::time_point now)
+{
+    std::scoped_lock lock(statusSync);
 
+    if (latencyProbeEnabled && now >= nextLatencyProbeTime)
+    {
+        ASAM_CMP_TRACE_SCOPE("CaptureLatencyProbe");
+        sendLatencyProbe();
+        nextLatencyProbeTime = now + latencyProbePeriod;
+    }
 
-            auto encodedData = encoders.encode(1, captureStatus.getPacket(), encoderContext);
+    if (now >= nextStatusTime)
+    {
+        ASAM_CMP_TRACE_SCOPE("CaptureStatus");
+        const auto encoderContext = createEncoderDataContext();
+        auto encodedData = encoders.encodeStatus(captureStatus.getPacket(), encoderContext);
+        for (const auto& e : encodedData)
+            ethernetWrapper->sendPacket(e);
+
+        for (int i = 0; i < captureStatus.getInterfaceStatusCount(); ++i)
+        {
+            encodedData = encoders.encodeStatus(captureStatus.getInterfaceStatus(i).getPacket(), encoderContext);
             for (const auto& e : encodedData)
                 ethernetWrapper->sendPacket(e);
-
-           
-            for (int i = 0; i < captureStatus.getInterfaceStatusCount(); ++i)
-            {
-                encodedData = encoders.encode(1, captureStatus.getInterfaceStatus(i).getPacket(), encoderContext);
-                for (const auto& e : encodedData)
-                    ethernetWrapper->sendPacket(e);
-            }
         }
+
+        if (statusBurstLeft > 0 && --statusBurstLeft > 0)
+            nextStatusTime = now + statusBurstPeriod;
+        else
+            nextStatusTime = now + std::chrono::milliseconds(sendingSyncLoopTime);
     }
-}
 
-void CaptureFb::startStatusLoop()
-{
-    stopStatusSending = false;
-    statusThread = std::thread{&CaptureFb::statusLoop, this};
+    return latencyProbeEnabled ? std::min(nextStatusTime, nextLatencyProbeTime) : nextStatusTime;
 }
 
-void CaptureFb::stopStatusLoop()
+void CaptureFb::sendLatencyProbe()
 {
-    {
-        std::scoped_lock<std::mutex> lock(sync);
-        stopStatusSending = true;
-    }
-    cv.notify_one();
-
-    statusThread.join();
+    const auto txTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+    ethernetWrapper->sendPacket(
+        asam_cmp_common_lib::encodeLatencyProbe({deviceId, latencyProbeCounter++, static_cast<uint64_t>(txTime.count())}));
 }
 
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
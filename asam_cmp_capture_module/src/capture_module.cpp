@@ -3,6 +3,7 @@
 #include <asam_cmp_capture_module/capture_module.h>
 #include <asam_cmp_capture_module/version.h>
 #include <asam_cmp_capture_module/capture_module_fb.h>
+#include <asam_cmp_capture_module/traffic_generator_fb.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
@@ -21,6 +22,9 @@ DictPtr<IString, IFunctionBlockType> CaptureModule::onGetAvailableFunctionBlockT
     auto typeStatistics = CaptureModuleFb::CreateType();
     types.set(typeStatistics.getId(), typeStatistics);
 
+    auto typeTrafficGenerator = TrafficGeneratorFb::CreateType();
+    types.set(typeTrafficGenerator.getId(), typeTrafficGenerator);
+
     return types;
 }
 
@@ -34,6 +38,11 @@ FunctionBlockPtr CaptureModule::onCreateFunctionBlock(const StringPtr& id,
         FunctionBlockPtr fb = CaptureModuleFb::create(context, parent, localId);
         return fb;
     }
+    if (id == TrafficGeneratorFb::CreateType().getId())
+    {
+        FunctionBlockPtr fb = TrafficGeneratorFb::create(context, parent, localId);
+        return fb;
+    }
 
     LOG_W("Function block \"{}\" not found", id);
     throw NotFoundException("Function block not found");
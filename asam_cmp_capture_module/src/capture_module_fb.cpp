@@ -1,12 +1,25 @@
 #include <asam_cmp_capture_module/capture_fb.h>
 #include <asam_cmp_capture_module/capture_module_fb.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
+#include <coreobjects/argument_info_factory.h>
+#include <coreobjects/callable_info_factory.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
 CaptureModuleFb::CaptureModuleFb(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId, const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper)
     : NetworkManagerFb(CreateType(), ctx, parent, localId, ethernetWrapper)
+    , statusTimer(std::make_shared<StatusTimer>())
 {
+#ifdef ASAM_CMP_ENABLE_LATENCY_HISTOGRAMS
+    using asam_cmp_common_lib::LatencyStage;
+    asam_cmp_common_lib::addLatencyProperties(objPtr, {LatencyStage::dequeue, LatencyStage::encode, LatencyStage::send});
+#endif
+#ifdef ASAM_CMP_ENABLE_TRACING
+    asam_cmp_common_lib::addTraceProperties(objPtr);
+#endif
+    initProperties();
     createFbs();
 }
 
@@ -22,13 +35,54 @@ FunctionBlockTypePtr CaptureModuleFb::CreateType()
     return FunctionBlockType("asam_cmp_capture_module", "AsamCmpCaptureModule", "ASAM CMP Capture Module");
 }
 
+void CaptureModuleFb::initProperties()
+{
+    StringPtr propName = "AddCapture";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { addCapture(); }));
+
+    propName = "RemoveCapture";
+    objPtr.addProperty(
+        FunctionPropertyBuilder(propName, ProcedureInfo(List<IArgumentInfo>(ArgumentInfo("nInd", ctInt)))).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this](IntPtr nInd) { removeCapture(nInd); }));
+}
+
 void CaptureModuleFb::createFbs()
 {
-    const StringPtr captureModuleId = "asam_cmp_capture";
-    CaptureFbInit init{ethernetWrapper, selectedEthernetDeviceName};
-    auto newFb = createWithImplementation<IFunctionBlock, CaptureFb>(
-        context, functionBlocks, captureModuleId, init);
+    addCaptureInternal("asam_cmp_capture", 0);
+}
+
+void CaptureModuleFb::addCapture()
+{
+    std::scoped_lock lock(sync);
+    // 0 is returned when no other id is free, it is a valid id only if it is not taken yet
+    const uint16_t deviceId = deviceIdManager.getFirstUnusedId();
+    if (deviceId == 0 && !deviceIdManager.isValidId(0))
+        throw std::runtime_error("No free device ID left");
+
+    addCaptureInternal(fmt::format("asam_cmp_capture_{}", createdCaptures), deviceId);
+}
+
+void CaptureModuleFb::removeCapture(size_t nInd)
+{
+    std::scoped_lock lock(sync);
+    const auto captures = functionBlocks.getItems();
+    if (nInd >= captures.getCount())
+        throw InvalidParameterException(fmt::format("Capture index {} is out of range", nInd));
+
+    FunctionBlockPtr captureFb = captures.getItemAt(nInd);
+    uint16_t deviceId = captureFb.getPropertyValue("DeviceId");
+    deviceIdManager.removeId(deviceId);
+    functionBlocks.removeItem(captureFb);
+}
+
+void CaptureModuleFb::addCaptureInternal(const StringPtr& fbId, uint16_t deviceId)
+{
+    CaptureFbInit init{ethernetWrapper, selectedEthernetDeviceName, &deviceIdManager, statusTimer, deviceId};
+    auto newFb = createWithImplementation<IFunctionBlock, CaptureFb>(context, functionBlocks, fbId, init);
     functionBlocks.addItem(newFb);
+    deviceIdManager.addId(deviceId);
+    ++createdCaptures;
 }
 
 void CaptureModuleFb::networkAdapterChangedInternal()
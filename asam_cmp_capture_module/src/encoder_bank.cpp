@@ -8,12 +8,21 @@ void EncoderBank::init(uint16_t deviceId)
         encoders[i].setDeviceId(deviceId);
         encoders[i].setStreamId(i);
     }
+    statusEncoder.setDeviceId(deviceId);
+    statusEncoder.setStreamId(statusStreamId);
 }
 
 std::vector<std::vector<uint8_t>> EncoderBank::encode(uint8_t encoderInd, const ASAM::CMP::Packet& packet, const ASAM::CMP::DataContext& dataContext)
 {
+    ASAM_CMP_LATENCY_SCOPE(encode);
     std::scoped_lock lock(encoderSyncs[encoderInd]);
     return encoders[encoderInd].encode(packet, dataContext);
 }
 
+std::vector<std::vector<uint8_t>> EncoderBank::encodeStatus(const ASAM::CMP::Packet& packet, const ASAM::CMP::DataContext& dataContext)
+{
+    std::scoped_lock lock(statusEncoderSync);
+    return statusEncoder.encode(packet, dataContext);
+}
+
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -22,23 +22,40 @@ InterfaceFb::InterfaceFb(const ContextPtr& ctx,
     , ethernetWrapper(internalInit.ethernetWrapper)
     , allowJumboFrames(internalInit.allowJumboFrames)
     , selectedDeviceName(internalInit.selectedDeviceName)
+    , statusChanged(internalInit.statusChanged)
 {
     initProperties();
+    if (internalInit.topology != nullptr)
+        applyTopology(*internalInit.topology);
     initStatusPacket();
-    updateInterfaceData();
 }
 
-void InterfaceFb::addStreamInternal()
+void InterfaceFb::applyTopology(const InterfaceTopology& topology)
 {
-    std::scoped_lock lock(statusSync);
+    // Streams are created before the status packet, so the interface status is built once for all of them
+    setPropertyValueInternal(
+        String("PayloadType").asPtr<IString>(true), BaseObjectPtr(topology.payloadType).asPtr<IBaseObject>(true), false, false, false);
+    payloadType.setType(payloadTypeToAsamPayloadType.at(topology.payloadType));
 
-    auto newId = streamIdManager.getFirstUnusedId();
+    for (const auto streamId : topology.streamIds)
+        addStreamWithId(streamId);
+}
+
+void InterfaceFb::addStreamWithId(uint8_t streamId)
+{
     StreamInit internalInit{streamIdsList, statusSync, interfaceId, ethernetWrapper, allowJumboFrames, encoders, [&]() {
                                 this->updateInterfaceData();
                             }};
-    addStreamWithParams<StreamFb>(newId, internalInit);
+    addStreamWithParams<StreamFb>(streamId, internalInit);
+
+    streamIdsList.insert(streamId);
+}
+
+void InterfaceFb::addStreamInternal()
+{
+    std::scoped_lock lock(statusSync);
 
-    streamIdsList.insert(newId);
+    addStreamWithId(streamIdManager.getFirstUnusedId());
     updateInterfaceData();
 }
 
@@ -121,6 +138,7 @@ void InterfaceFb::updateInterfaceData()
                  static_cast<uint16_t>(vendorData.size()));
 
     deviceStatus.update(interfaceStatusPacket);
+    statusChanged();
 }
 
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,93 @@
+#include <asam_cmp_capture_module/status_timer.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+StatusTimer::~StatusTimer()
+{
+    {
+        std::scoped_lock lock(sync);
+        stop = true;
+    }
+    cv.notify_one();
+
+    if (thread.joinable())
+        thread.join();
+}
+
+size_t StatusTimer::add(Callback callback, Clock::time_point firstTime)
+{
+    size_t id;
+    {
+        std::scoped_lock lock(clientsSync);
+        id = nextId++;
+        clients.emplace(id, Client{std::move(callback), firstTime});
+    }
+
+    {
+        std::scoped_lock lock(sync);
+        if (!thread.joinable())
+            thread = std::thread{&StatusTimer::loop, this};
+        wakeRequested = true;
+    }
+    cv.notify_one();
+
+    return id;
+}
+
+void StatusTimer::remove(size_t id)
+{
+    // Callbacks run under the lock, so none of them is in progress here
+    std::scoped_lock lock(clientsSync);
+    clients.erase(id);
+}
+
+void StatusTimer::wake()
+{
+    {
+        std::scoped_lock lock(sync);
+        wakeRequested = true;
+    }
+    cv.notify_one();
+}
+
+void StatusTimer::loop()
+{
+    auto nextTime = Clock::time_point::max();
+    std::unique_lock lock(sync);
+    while (!stop)
+    {
+        const auto wakeCondition = [this] { return stop || wakeRequested; };
+        if (nextTime == Clock::time_point::max())
+            cv.wait(lock, wakeCondition);
+        else
+            cv.wait_until(lock, nextTime, wakeCondition);
+        if (stop)
+            break;
+
+        const bool callAll = wakeRequested;
+        wakeRequested = false;
+
+        lock.unlock();
+        nextTime = callClients(callAll);
+        lock.lock();
+    }
+}
+
+StatusTimer::Clock::time_point StatusTimer::callClients(bool callAll)
+{
+    std::scoped_lock lock(clientsSync);
+
+    const auto now = Clock::now();
+    auto nextTime = Clock::time_point::max();
+    for (auto& [id, client] : clients)
+    {
+        if (callAll || now >= client.nextTime)
+            client.nextTime = client.callback(now);
+        nextTime = std::min(nextTime, client.nextTime);
+    }
+
+    return nextTime;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -9,10 +9,13 @@
 #include <coretypes/enumeration_type_factory.h>
 #include <asam_cmp_capture_module/input_descriptors_validator.h>
 #include <asam_cmp_capture_module/dispatch.h>
+#include <asam_cmp_capture_module/analog_payload_builder.h>
 #include <asam_cmp/can_payload.h>
 #include <asam_cmp/can_fd_payload.h>
 #include <asam_cmp/analog_payload.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
 #include <asam_cmp_common_lib/unit_converter.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -237,7 +240,7 @@ void StreamFb::onPacketReceived(const InputPortPtr& port)
     if (!connection.assigned())
         return;
 
-    packet = connection.dequeue();
+    packet = dequeuePacket(connection);
 
     while (packet.assigned())
     {
@@ -255,10 +258,16 @@ void StreamFb::onPacketReceived(const InputPortPtr& port)
                 break;
         }
 
-        packet = connection.dequeue();
+        packet = dequeuePacket(connection);
     };
 }
 
+PacketPtr StreamFb::dequeuePacket(const ConnectionPtr& connection)
+{
+    ASAM_CMP_LATENCY_SCOPE(dequeue);
+    return connection.dequeue();
+}
+
 void StreamFb::processSignalDescriptorChanged(DataDescriptorPtr inputDataDescriptor, DataDescriptorPtr inputDomainDataDescriptor)
 {
     if (inputDataDescriptor.assigned())
@@ -394,59 +403,6 @@ void StreamFb::processCanFdPacket(const DataPacketPtr& packet)
         ethernetWrapper->sendPacket(rawFrame);
 }
 
-template <SampleType SrcType>
-void createAnalogPayloadWithInternalScaling(ASAM::CMP::AnalogPayload& payload,
-                                            const daq::DataPacketPtr& packet,
-                                            Float analogDataScale,
-                                            Float analogDataOffset,
-                                            Float analogDataDeltaTime)
-{
-    payload.setSampleInterval(analogDataDeltaTime);
-
-    using SourceType = typename SampleTypeToType<SrcType>::Type;
-    auto* rawData = reinterpret_cast<SourceType*>(packet.getRawData());
-    const size_t sampleCount = packet.getSampleCount();
-
-    uint8_t unitId = asam_cmp_common_lib::Units::getIdBySymbol(packet.getDataDescriptor().getUnit().getSymbol().toStdString());
-    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(unitId));
-    payload.setSampleDt(ASAM::CMP::AnalogPayload::SampleDt::aInt32);
-    payload.setSampleScalar(analogDataScale);
-    payload.setSampleOffset(analogDataOffset);
-
-    std::vector<int32_t> scaledData(sampleCount);
-    for (int i = 0; i < sampleCount; ++i)
-    {
-        scaledData[i] = std::round((rawData[i] - analogDataOffset) / analogDataScale);
-    }
-
-    payload.setData(reinterpret_cast<uint8_t*>(scaledData.data()), sampleCount * sizeof(int32_t));
-}
-
-void createAnalogPayload(ASAM::CMP::AnalogPayload& payload,
-                         const DataPacketPtr& packet,
-                         const DataDescriptorPtr& inputDataDescriptor,
-                         Float analogDataScale,
-                         Float analogDataOffset,
-                         Float analogDataDeltaTime,
-                         Int analogDataSampleDt)
-{
-    payload.setSampleInterval(analogDataDeltaTime);
-
-    auto* rawData = reinterpret_cast<uint8_t*>(packet.getRawData());
-    const size_t sampleCount = packet.getSampleCount();
-    const auto inputSampleType = inputDataDescriptor.getPostScaling().assigned() ? inputDataDescriptor.getPostScaling().getInputSampleType()
-                                                                                 : inputDataDescriptor.getSampleType();
-    const size_t sampleSize = inputSampleType == SampleType::Int16 ? 2 : 4;
-
-    uint8_t unitId = asam_cmp_common_lib::Units::getIdBySymbol(packet.getDataDescriptor().getUnit().getSymbol().toStdString());
-    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(unitId));
-    payload.setSampleDt(analogDataSampleDt == 16 ? ASAM::CMP::AnalogPayload::SampleDt::aInt16 : ASAM::CMP::AnalogPayload::SampleDt::aInt32);
-    payload.setSampleScalar(analogDataScale);
-    payload.setSampleOffset(analogDataOffset);
-
-    payload.setData(rawData, sampleCount * sampleSize);
-}
-
 void StreamFb::processAnalogPacket(const DataPacketPtr& packet)
 {
     ASAM::CMP::AnalogPayload payload;
@@ -478,6 +434,9 @@ void StreamFb::processAnalogPacket(const DataPacketPtr& packet)
 
 void StreamFb::processDataPacket(const DataPacketPtr& packet)
 {
+    ASAM_CMP_TRACE_SCOPE("CaptureStreamProcess");
+    ASAM_CMP_TRACE_COUNTER("CaptureStreamSamples", packet.getSampleCount());
+
     switch (payloadType.getType())
     {
         case ASAM::CMP::PayloadType::can:
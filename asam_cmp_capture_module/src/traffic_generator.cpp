@@ -0,0 +1,262 @@
+#include <asam_cmp_capture_module/traffic_generator.h>
+#include <asam_cmp/analog_payload.h>
+#include <asam_cmp/can_fd_payload.h>
+#include <asam_cmp/can_payload.h>
+#include <asam_cmp/capture_module_payload.h>
+#include <asam_cmp/interface_payload.h>
+#include <asam_cmp/payload_type.h>
+#include <asam_cmp_common_lib/unit_converter.h>
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    constexpr uint64_t nsInMs = 1'000'000;
+
+    uint8_t getRawPayloadType(GeneratorPayloadType payloadType)
+    {
+        ASAM::CMP::PayloadType type;
+        switch (payloadType)
+        {
+            case GeneratorPayloadType::canFd:
+                type.setType(ASAM::CMP::PayloadType::canFd);
+                break;
+            case GeneratorPayloadType::analog:
+                type.setType(ASAM::CMP::PayloadType::analog);
+                break;
+            default:
+                type.setType(ASAM::CMP::PayloadType::can);
+        }
+        return type.getRawPayloadType();
+    }
+
+    std::vector<double> createZipfWeights(uint32_t count)
+    {
+        std::vector<double> weights(count);
+        for (uint32_t i = 0; i < count; ++i)
+            weights[i] = 1.0 / (i + 1);
+        return weights;
+    }
+}
+
+TrafficGenerator::TrafficGenerator(const TrafficGeneratorConfig& config,
+                                   const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper)
+    : config(config)
+    , ethernetWrapper(ethernetWrapper)
+    , canData(64)
+    , analogData(config.analogSamplesPerMessage)
+    , uniformCanIds(0, std::max<uint32_t>(config.canIdCount, 1) - 1)
+{
+    const auto zipfWeights = createZipfWeights(std::max<uint32_t>(config.canIdCount, 1));
+    zipfCanIds = std::discrete_distribution<uint32_t>(zipfWeights.begin(), zipfWeights.end());
+
+    std::iota(canData.begin(), canData.end(), uint8_t{0});
+    for (size_t i = 0; i < analogData.size(); ++i)
+        analogData[i] = static_cast<int16_t>(i * 64);
+
+    const size_t streamCount = size_t{config.deviceCount} * config.interfacesPerDevice * config.streamsPerInterface;
+    for (size_t deviceInd = 0; deviceInd < config.deviceCount; ++deviceInd)
+    {
+        encoders.push_back(std::make_unique<EncoderBank>());
+        encoders.back()->init(static_cast<uint16_t>(config.firstDeviceId + deviceInd));
+
+        for (uint32_t interfaceId = 0; interfaceId < config.interfacesPerDevice; ++interfaceId)
+        {
+            const auto payloadType = getInterfacePayloadType(config.payloadType, interfaceId);
+            for (uint32_t streamInd = 0; streamInd < config.streamsPerInterface; ++streamInd)
+                streams.push_back({deviceInd,
+                                   interfaceId,
+                                   static_cast<uint8_t>(streamInd + 1),
+                                   payloadType,
+                                   getStreamRate(streams.size(), streamCount)});
+        }
+    }
+
+    createStatusPackets();
+}
+
+double TrafficGenerator::getStreamRate(size_t streamInd, size_t streamCount) const
+{
+    const double spread = std::clamp(config.messageRateSpread, 0.0, 1.0);
+    if (streamCount < 2 || spread == 0.0)
+        return config.messageRate;
+
+    const double position = static_cast<double>(streamInd) / (streamCount - 1) * 2.0 - 1.0;
+    return config.messageRate * (1.0 + spread * position);
+}
+
+GeneratorPayloadType TrafficGenerator::getInterfacePayloadType(GeneratorPayloadType payloadType, uint32_t interfaceId)
+{
+    if (payloadType != GeneratorPayloadType::mixed)
+        return payloadType;
+
+    constexpr std::array<GeneratorPayloadType, 3> mixedTypes{GeneratorPayloadType::can, GeneratorPayloadType::canFd, GeneratorPayloadType::analog};
+    return mixedTypes[interfaceId % mixedTypes.size()];
+}
+
+void TrafficGenerator::createStatusPackets()
+{
+    const std::vector<uint8_t> vendorData;
+    std::vector<uint8_t> streamIds(config.streamsPerInterface);
+    std::iota(streamIds.begin(), streamIds.end(), uint8_t{1});
+
+    statusPackets.resize(config.deviceCount);
+    for (size_t deviceInd = 0; deviceInd < config.deviceCount; ++deviceInd)
+    {
+        auto& packets = statusPackets[deviceInd];
+
+        ASAM::CMP::CaptureModulePayload capturePayload;
+        capturePayload.setData("TrafficGenerator", std::to_string(config.firstDeviceId + deviceInd), "", "", vendorData);
+        auto& capturePacket = packets.emplace_back();
+        capturePacket.setPayload(capturePayload);
+        capturePacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+
+        for (uint32_t interfaceId = 0; interfaceId < config.interfacesPerDevice; ++interfaceId)
+        {
+            ASAM::CMP::InterfacePayload interfacePayload;
+            interfacePayload.setInterfaceId(interfaceId);
+            interfacePayload.setInterfaceType(getRawPayloadType(getInterfacePayloadType(config.payloadType, interfaceId)));
+            interfacePayload.setInterfaceStatus(ASAM::CMP::InterfacePayload::InterfaceStatus::linkStatusUp);
+            interfacePayload.setData(streamIds.data(), static_cast<uint16_t>(streamIds.size()), vendorData.data(), 0);
+
+            auto& interfacePacket = packets.emplace_back();
+            interfacePacket.setPayload(interfacePayload);
+            interfacePacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+        }
+    }
+}
+
+void TrafficGenerator::step(uint64_t now)
+{
+    if (startTime == 0)
+    {
+        startTime = now;
+        nextBurstTime = now;
+        nextStatusTime = now;
+    }
+
+    if (config.statusPeriod.count() > 0 && now >= nextStatusTime)
+    {
+        sendStatus();
+        nextStatusTime += config.statusPeriod.count() * nsInMs;
+        if (nextStatusTime <= now)
+            nextStatusTime = now + config.statusPeriod.count() * nsInMs;
+    }
+
+    if (config.burstPeriod.count() > 0)
+    {
+        if (now < nextBurstTime)
+            return;
+        nextBurstTime += config.burstPeriod.count() * nsInMs;
+    }
+
+    for (auto& stream : streams)
+    {
+        if (stream.rate <= 0)
+            continue;
+
+        const auto due = static_cast<uint64_t>((now - startTime) * stream.rate / 1e9) + 1;
+        if (due <= stream.sent)
+            continue;
+
+        // Messages beyond the backlog limit are skipped rather than sent late
+        const auto maxCount = static_cast<uint64_t>(std::max(stream.rate * maxBacklog, 1.0));
+        if (due - stream.sent > maxCount)
+            stream.sent = due - maxCount;
+
+        const size_t count = due - stream.sent;
+        sendData(stream, count, now);
+        stream.sent = due;
+    }
+}
+
+void TrafficGenerator::sendStatus()
+{
+    for (size_t deviceInd = 0; deviceInd < statusPackets.size(); ++deviceInd)
+    {
+        for (const auto& packet : statusPackets[deviceInd])
+            sendFrames(encoders[deviceInd]->encodeStatus(packet, dataContext));
+    }
+}
+
+void TrafficGenerator::sendData(Stream& stream, size_t count, uint64_t now)
+{
+    dataPackets.clear();
+    dataPackets.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& packet = dataPackets.emplace_back();
+        packet.setInterfaceId(stream.interfaceId);
+        packet.setTimestamp(now);
+
+        switch (stream.payloadType)
+        {
+            case GeneratorPayloadType::canFd:
+            {
+                ASAM::CMP::CanFdPayload payload;
+                payload.setData(canData.data(), config.canFdDataLength);
+                payload.setId(getNextCanId(stream));
+                packet.setPayload(payload);
+                break;
+            }
+            case GeneratorPayloadType::analog:
+            {
+                ASAM::CMP::AnalogPayload payload;
+                payload.setData(reinterpret_cast<const uint8_t*>(analogData.data()), analogData.size() * sizeof(int16_t));
+                payload.setSampleDt(ASAM::CMP::AnalogPayload::SampleDt::aInt16);
+                payload.setUnit(ASAM::CMP::AnalogPayload::Unit(asam_cmp_common_lib::Units::getIdBySymbol("V")));
+                payload.setSampleInterval(static_cast<float>(1.0 / (stream.rate * analogData.size())));
+                payload.setSampleOffset(0.f);
+                payload.setSampleScalar(1e-3f);
+                packet.setPayload(payload);
+                break;
+            }
+            default:
+            {
+                ASAM::CMP::CanPayload payload;
+                payload.setData(canData.data(), std::min<uint8_t>(config.canDataLength, 8));
+                payload.setId(getNextCanId(stream));
+                packet.setPayload(payload);
+            }
+        }
+    }
+
+    sendFrames(encoders[stream.deviceInd]->encode(stream.streamId, dataPackets.begin(), dataPackets.end(), dataContext));
+    sentMessages += count;
+}
+
+void TrafficGenerator::sendFrames(const std::vector<std::vector<uint8_t>>& frames)
+{
+    for (const auto& frame : frames)
+        ethernetWrapper->sendPacket(frame);
+    sentFrames += frames.size();
+}
+
+uint32_t TrafficGenerator::getNextCanId(Stream& stream)
+{
+    switch (config.canIdDistribution)
+    {
+        case CanIdDistribution::uniform:
+            return uniformCanIds(random);
+        case CanIdDistribution::zipf:
+            return zipfCanIds(random);
+        default:
+            return stream.canIdCounter++ % std::max<uint32_t>(config.canIdCount, 1);
+    }
+}
+
+uint64_t TrafficGenerator::getSentFrames() const
+{
+    return sentFrames;
+}
+
+uint64_t TrafficGenerator::getSentMessages() const
+{
+    return sentMessages;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
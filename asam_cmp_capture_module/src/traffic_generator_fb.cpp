@@ -0,0 +1,166 @@
+#include <asam_cmp_capture_module/traffic_generator_fb.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <coreobjects/unit_factory.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+TrafficGeneratorFb::TrafficGeneratorFb(const ContextPtr& ctx,
+                                       const ComponentPtr& parent,
+                                       const StringPtr& localId,
+                                       const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper)
+    : NetworkManagerFb(CreateType(), ctx, parent, localId, ethernetWrapper)
+{
+    initProperties();
+    readConfig();
+}
+
+TrafficGeneratorFb::~TrafficGeneratorFb()
+{
+    stopGeneratorLoop();
+}
+
+FunctionBlockPtr TrafficGeneratorFb::create(const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId)
+{
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ptr = std::make_shared<asam_cmp_common_lib::EthernetPcppImpl>();
+    auto fb = createWithImplementation<IFunctionBlock, TrafficGeneratorFb>(ctx, parent, localId, ptr);
+    return fb;
+}
+
+FunctionBlockTypePtr TrafficGeneratorFb::CreateType()
+{
+    return FunctionBlockType("asam_cmp_traffic_generator", "AsamCmpTrafficGenerator", "ASAM CMP Traffic Generator");
+}
+
+void TrafficGeneratorFb::initProperties()
+{
+    StringPtr propName = "Enabled";
+    objPtr.addProperty(BoolProperty(propName, False));
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { restartGenerator(); };
+
+    addConfigProperty(IntPropertyBuilder("FirstDeviceId", config.firstDeviceId).setMinValue(0).setMaxValue(65535).build());
+    addConfigProperty(IntPropertyBuilder("DeviceCount", config.deviceCount).setMinValue(1).setMaxValue(256).build());
+    addConfigProperty(IntPropertyBuilder("InterfacesPerDevice", config.interfacesPerDevice).setMinValue(1).setMaxValue(1024).build());
+    addConfigProperty(IntPropertyBuilder("StreamsPerInterface", config.streamsPerInterface).setMinValue(1).setMaxValue(254).build());
+
+    addConfigProperty(SelectionPropertyBuilder("PayloadType", ListPtr<StringPtr>{"CAN", "CAN_FD", "ANALOG", "MIXED"}, 0).build());
+    addConfigProperty(FloatPropertyBuilder("MessageRate", config.messageRate).setMinValue(0.0).setMaxValue(1'000'000.0).build());
+    addConfigProperty(
+        FloatPropertyBuilder("MessageRateSpread", config.messageRateSpread * 100.0).setMinValue(0.0).setMaxValue(100.0).setUnit(Unit("%")).build());
+
+    addConfigProperty(SelectionPropertyBuilder("CanIdDistribution", ListPtr<StringPtr>{"Sequential", "Uniform", "Zipf"}, 0).build());
+    addConfigProperty(IntPropertyBuilder("CanIdCount", config.canIdCount).setMinValue(1).setMaxValue(2048).build());
+    addConfigProperty(IntPropertyBuilder("CanDataLength", config.canDataLength).setMinValue(0).setMaxValue(8).build());
+    addConfigProperty(IntPropertyBuilder("CanFdDataLength", config.canFdDataLength).setMinValue(0).setMaxValue(64).build());
+    addConfigProperty(IntPropertyBuilder("AnalogSamplesPerMessage", config.analogSamplesPerMessage).setMinValue(1).setMaxValue(700).build());
+
+    addConfigProperty(IntPropertyBuilder("BurstPeriod", config.burstPeriod.count()).setMinValue(0).setMaxValue(60000).setUnit(Unit("ms")).build());
+    addConfigProperty(IntPropertyBuilder("StatusPeriod", config.statusPeriod.count()).setMinValue(0).setMaxValue(60000).setUnit(Unit("ms")).build());
+
+    addCounterProperties();
+}
+
+void TrafficGeneratorFb::addConfigProperty(const PropertyPtr& prop)
+{
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(prop.getName()) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        restartGenerator();
+    };
+}
+
+void TrafficGeneratorFb::addCounterProperties()
+{
+    StringPtr propName = "SentFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(sentFrames.load()));
+    };
+
+    propName = "SentMessages";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        args.setValue(static_cast<Int>(sentMessages.load()));
+    };
+}
+
+void TrafficGeneratorFb::readConfig()
+{
+    config.firstDeviceId = static_cast<uint16_t>(static_cast<Int>(objPtr.getPropertyValue("FirstDeviceId")));
+    config.deviceCount = static_cast<uint16_t>(static_cast<Int>(objPtr.getPropertyValue("DeviceCount")));
+    config.interfacesPerDevice = static_cast<uint32_t>(static_cast<Int>(objPtr.getPropertyValue("InterfacesPerDevice")));
+    config.streamsPerInterface = static_cast<uint32_t>(static_cast<Int>(objPtr.getPropertyValue("StreamsPerInterface")));
+    config.payloadType = static_cast<GeneratorPayloadType>(static_cast<Int>(objPtr.getPropertyValue("PayloadType")));
+    config.messageRate = objPtr.getPropertyValue("MessageRate");
+    config.messageRateSpread = static_cast<Float>(objPtr.getPropertyValue("MessageRateSpread")) / 100.0;
+    config.canIdDistribution = static_cast<CanIdDistribution>(static_cast<Int>(objPtr.getPropertyValue("CanIdDistribution")));
+    config.canIdCount = static_cast<uint32_t>(static_cast<Int>(objPtr.getPropertyValue("CanIdCount")));
+    config.canDataLength = static_cast<uint8_t>(static_cast<Int>(objPtr.getPropertyValue("CanDataLength")));
+    config.canFdDataLength = static_cast<uint8_t>(static_cast<Int>(objPtr.getPropertyValue("CanFdDataLength")));
+    config.analogSamplesPerMessage = static_cast<uint16_t>(static_cast<Int>(objPtr.getPropertyValue("AnalogSamplesPerMessage")));
+    config.burstPeriod = std::chrono::milliseconds(static_cast<Int>(objPtr.getPropertyValue("BurstPeriod")));
+    config.statusPeriod = std::chrono::milliseconds(static_cast<Int>(objPtr.getPropertyValue("StatusPeriod")));
+}
+
+void TrafficGeneratorFb::restartGenerator()
+{
+    stopGeneratorLoop();
+    readConfig();
+    if (static_cast<bool>(objPtr.getPropertyValue("Enabled")))
+        startGeneratorLoop();
+}
+
+void TrafficGeneratorFb::startGeneratorLoop()
+{
+    generator = std::make_unique<TrafficGenerator>(config, ethernetWrapper);
+    {
+        std::scoped_lock lock(generatorSync);
+        stopGenerator = false;
+    }
+    generatorThread = std::thread{&TrafficGeneratorFb::generatorLoop, this};
+}
+
+void TrafficGeneratorFb::stopGeneratorLoop()
+{
+    {
+        std::scoped_lock lock(generatorSync);
+        stopGenerator = true;
+    }
+    cv.notify_one();
+    if (generatorThread.joinable())
+        generatorThread.join();
+
+    if (generator)
+    {
+        previousSentFrames += generator->getSentFrames();
+        previousSentMessages += generator->getSentMessages();
+        sentFrames = previousSentFrames;
+        sentMessages = previousSentMessages;
+        generator.reset();
+    }
+}
+
+void TrafficGeneratorFb::generatorLoop()
+{
+    // The generator is only replaced while this thread is not running, so it is stepped without the lock
+    std::unique_lock<std::mutex> lock(generatorSync);
+    while (!stopGenerator)
+    {
+        lock.unlock();
+        const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+        generator->step(static_cast<uint64_t>(now.count()));
+        sentFrames = previousSentFrames + generator->getSentFrames();
+        sentMessages = previousSentMessages + generator->getSentMessages();
+        lock.lock();
+
+        cv.wait_for(lock, generatorLoopTime, [this] { return stopGenerator; });
+    }
+}
+
+void TrafficGeneratorFb::networkAdapterChangedInternal()
+{
+    restartGenerator();
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
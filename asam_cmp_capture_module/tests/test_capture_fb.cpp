@@ -4,9 +4,11 @@
 #include <opendaq/module_ptr.h>
 #include <opendaq/scheduler_factory.h>
 #include <gtest/gtest.h>
+#include <coretypes/dictobject_factory.h>
 
 #include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
 #include <asam_cmp/decoder.h>
+#include <asam_cmp/interface_payload.h>
 
 using namespace daq;
 using namespace testing;
@@ -113,6 +115,104 @@ TEST_F(CaptureFbTest, TestCreateInterface)
     ASSERT_EQ(captureFb.getFunctionBlocks().getItemAt(0).getPropertyValue("InterfaceId"), lstId);
 }
 
+TEST_F(CaptureFbTest, ConfigureTopology)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = captureFb.getPropertyValue("AddInterface");
+    createProc();
+
+    auto canInterface = Dict<IString, IBaseObject>();
+    canInterface.set("InterfaceId", 10);
+    canInterface.set("PayloadType", 1);
+    canInterface.set("StreamCount", 32);
+
+    auto analogInterface = Dict<IString, IBaseObject>();
+    analogInterface.set("InterfaceId", 20);
+    analogInterface.set("PayloadType", 3);
+    analogInterface.set("StreamIds", List<IBaseObject>(5, 7));
+
+    ProcedurePtr configureProc = captureFb.getPropertyValue("ConfigureTopology");
+    configureProc(List<IBaseObject>(canInterface, analogInterface));
+
+    const auto interfaces = captureFb.getFunctionBlocks();
+    ASSERT_EQ(interfaces.getCount(), 2u);
+
+    Int interfaceId = interfaces[0].getPropertyValue("InterfaceId");
+    Int payloadType = interfaces[0].getPropertyValue("PayloadType");
+    ASSERT_EQ(interfaceId, 10);
+    ASSERT_EQ(payloadType, 1);
+    ASSERT_EQ(interfaces[0].getFunctionBlocks().getCount(), 32u);
+
+    interfaceId = interfaces[1].getPropertyValue("InterfaceId");
+    payloadType = interfaces[1].getPropertyValue("PayloadType");
+    ASSERT_EQ(interfaceId, 20);
+    ASSERT_EQ(payloadType, 3);
+    const auto streams = interfaces[1].getFunctionBlocks();
+    ASSERT_EQ(streams.getCount(), 2u);
+    Int streamId = streams[1].getPropertyValue("StreamId");
+    ASSERT_EQ(streamId, 7);
+
+    // Stream ids left free by the topology are still handed out by AddStream
+    ProcedurePtr addStreamProc = interfaces[1].getPropertyValue("AddStream");
+    addStreamProc();
+    streamId = interfaces[1].getFunctionBlocks()[2].getPropertyValue("StreamId");
+    ASSERT_EQ(streamId, 1);
+}
+
+TEST_F(CaptureFbTest, ConfigureInvalidTopology)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = captureFb.getPropertyValue("AddInterface");
+    createProc();
+
+    auto firstInterface = Dict<IString, IBaseObject>();
+    firstInterface.set("InterfaceId", 10);
+    auto duplicatedInterface = Dict<IString, IBaseObject>();
+    duplicatedInterface.set("InterfaceId", 10);
+
+    ProcedurePtr configureProc = captureFb.getPropertyValue("ConfigureTopology");
+    ASSERT_ANY_THROW(configureProc(List<IBaseObject>(firstInterface, duplicatedInterface)));
+
+    auto invalidStreams = Dict<IString, IBaseObject>();
+    invalidStreams.set("InterfaceId", 11);
+    invalidStreams.set("StreamIds", List<IBaseObject>(3, 3));
+    ASSERT_ANY_THROW(configureProc(List<IBaseObject>(invalidStreams)));
+
+    ASSERT_EQ(captureFb.getFunctionBlocks().getCount(), 1u);
+}
+
+TEST_F(CaptureFbTest, StatusBurstOnTopologyChange)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(1));
+
+    // Let the startup burst pass, the next regular status is a second away
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+    ProcedurePtr createProc = captureFb.getPropertyValue("AddInterface");
+    createProc();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    ProcedurePtr addStreamProc = interfaceFb.getPropertyValue("AddStream");
+    addStreamProc();
+
+    auto checker = [&]()
+    {
+        std::scoped_lock lock(packedReceivedSync);
+
+        if (!lastReceivedPacket.isValid() || lastReceivedPacket.getPayload().getType() != ASAM::CMP::PayloadType::ifStatMsg)
+            return false;
+
+        return static_cast<ASAM::CMP::InterfacePayload&>(lastReceivedPacket.getPayload()).getStreamIdsCount() == 1;
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (!checker() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_TRUE(checker());
+}
+
 TEST_F(CaptureFbTest, TestCaptureStatusReceived)
 {
     EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(1));
@@ -0,0 +1,125 @@
+#include <asam_cmp_capture_module/capture_module_fb.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp/decoder.h>
+
+#include <set>
+#include <thread>
+
+using namespace daq;
+using namespace testing;
+
+class CaptureModuleFbTest : public testing::Test
+{
+protected:
+    CaptureModuleFbTest()
+        : ethernetWrapper(std::make_shared<asam_cmp_common_lib::EthernetPcppMock>())
+    {
+        names = List<IString>();
+        names.pushBack("name1");
+        descriptions = List<IString>();
+        descriptions.pushBack("desc1");
+
+        ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(names));
+        ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
+        ON_CALL(*ethernetWrapper, sendPacket(_))
+            .WillByDefault(WithArgs<0>(Invoke([this](const std::vector<uint8_t>& data) { onPacketSend(data); })));
+
+        auto logger = Logger();
+        context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+        funcBlock = createWithImplementation<IFunctionBlock, modules::asam_cmp_capture_module::CaptureModuleFb>(
+            context, nullptr, "asam_cmp_capture_module_fb", ethernetWrapper);
+    }
+
+    std::set<Int> getDeviceIds()
+    {
+        std::set<Int> ids;
+        for (const auto& captureFb : funcBlock.getFunctionBlocks())
+            ids.insert(captureFb.getPropertyValue("DeviceId"));
+        return ids;
+    }
+
+    void onPacketSend(const std::vector<uint8_t>& data)
+    {
+        std::scoped_lock lock(sendSync);
+        for (const auto& packet : decoder.decode(data.data(), data.size()))
+            statusDeviceIds.insert(packet->getDeviceId());
+        senderThreads.insert(std::this_thread::get_id());
+    }
+
+protected:
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppMock> ethernetWrapper;
+    ListPtr<StringPtr> names;
+    ListPtr<StringPtr> descriptions;
+
+    ContextPtr context;
+    FunctionBlockPtr funcBlock;
+
+    std::mutex sendSync;
+    ASAM::CMP::Decoder decoder;
+    std::set<uint16_t> statusDeviceIds;
+    std::set<std::thread::id> senderThreads;
+};
+
+TEST_F(CaptureModuleFbTest, AddRemoveCapture)
+{
+    ASSERT_EQ(funcBlock.getFunctionBlocks().getCount(), 1u);
+
+    ProcedurePtr addCapture = funcBlock.getPropertyValue("AddCapture");
+    addCapture();
+    addCapture();
+    ASSERT_EQ(getDeviceIds(), (std::set<Int>{0, 1, 2}));
+
+    ProcedurePtr removeCapture = funcBlock.getPropertyValue("RemoveCapture");
+    removeCapture(1);
+    ASSERT_EQ(getDeviceIds(), (std::set<Int>{0, 2}));
+
+    ASSERT_ANY_THROW(removeCapture(2));
+    ASSERT_EQ(getDeviceIds(), (std::set<Int>{0, 2}));
+
+    addCapture();
+    ASSERT_EQ(getDeviceIds(), (std::set<Int>{0, 1, 2}));
+}
+
+TEST_F(CaptureModuleFbTest, DeviceIdsAreDistinct)
+{
+    funcBlock.getPropertyValue("AddCapture").execute();
+    auto captureFb = funcBlock.getFunctionBlocks()[1];
+    Int id = captureFb.getPropertyValue("DeviceId");
+    ASSERT_EQ(id, 1);
+
+    captureFb.setPropertyValue("DeviceId", 0);
+    id = captureFb.getPropertyValue("DeviceId");
+    ASSERT_EQ(id, 1);
+
+    captureFb.setPropertyValue("DeviceId", 5);
+    id = captureFb.getPropertyValue("DeviceId");
+    ASSERT_EQ(id, 5);
+    ASSERT_EQ(getDeviceIds(), (std::set<Int>{0, 5}));
+}
+
+TEST_F(CaptureModuleFbTest, StatusOfAllCapturesFromOneThread)
+{
+    ProcedurePtr addCapture = funcBlock.getPropertyValue("AddCapture");
+    addCapture();
+    addCapture();
+
+    const std::set<uint16_t> expectedIds{0, 1, 2};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::scoped_lock lock(sendSync);
+            if (statusDeviceIds == expectedIds)
+                break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::scoped_lock lock(sendSync);
+    ASSERT_EQ(statusDeviceIds, expectedIds);
+    ASSERT_EQ(senderThreads.size(), 1u);
+}
@@ -0,0 +1,166 @@
+#include <asam_cmp_capture_module/capture_fb.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/dimension_factory.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <opendaq/signal_factory.h>
+#include <coreobjects/unit_factory.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include "include/ref_can_channel_impl.h"
+#include <allocation_counter.h>
+
+using namespace daq;
+using namespace testing;
+using namespace std::chrono_literals;
+
+class HotPathAllocationsTest : public testing::Test
+{
+protected:
+    HotPathAllocationsTest()
+        : ethernetWrapper(std::make_shared<NiceMock<asam_cmp_common_lib::EthernetPcppMock>>())
+    {
+        ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(names));
+        ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
+        ON_CALL(*ethernetWrapper, sendPacket(_))
+            .WillByDefault(
+                [this](const std::vector<uint8_t>& data)
+                {
+                    // Messages are encoded and sent on the sender thread
+                    AllocationCounter::countCurrentThread();
+
+                    constexpr size_t messageTypeOffset = 4;
+                    constexpr uint8_t dataMessageType = 1;
+                    if (data.size() > messageTypeOffset && data[messageTypeOffset] == dataMessageType)
+                        ++sentDataFrames;
+                });
+
+        auto logger = Logger();
+        context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+        modules::asam_cmp_capture_module::CaptureFbInit init = {ethernetWrapper, "device1"};
+        captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_capture_module::CaptureFb>(
+            context, nullptr, "asam_cmp_capture_fb", init);
+
+        captureFb.getPropertyValue("AddInterface").execute();
+        auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+        interfaceFb.setPropertyValue("PayloadType", 1);
+        interfaceFb.getPropertyValue("AddStream").execute();
+        streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+        createSignals();
+    }
+
+    void createSignals()
+    {
+        const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+        const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+        const auto dataDescriptor =
+            DataDescriptorBuilder()
+                .setName("Data")
+                .setSampleType(SampleType::UInt8)
+                .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+                .build();
+        const auto canDescriptor = DataDescriptorBuilder()
+                                       .setSampleType(SampleType::Struct)
+                                       .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+                                       .setName("CAN")
+                                       .build();
+        const auto timeDescriptor = DataDescriptorBuilder()
+                                        .setSampleType(SampleType::Int64)
+                                        .setUnit(Unit("s", -1, "seconds", "time"))
+                                        .setTickResolution(Ratio(1, 1000000))
+                                        .setOrigin(RefCANChannelImpl::getEpoch())
+                                        .setName("Time CAN")
+                                        .build();
+
+        timeSignal = SignalWithDescriptor(context, timeDescriptor, nullptr, "time");
+        valueSignal = SignalWithDescriptor(context, canDescriptor, nullptr, "can");
+        valueSignal.setDomainSignal(timeSignal);
+    }
+
+    DataPacketPtr createCanPacket(size_t messagesCount) const
+    {
+        const auto domainPacket = DataPacket(timeSignal.getDescriptor(), messagesCount, 0);
+        const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), messagesCount);
+
+        auto* canData = static_cast<CANData*>(dataPacket.getRawData());
+        auto* timeBuffer = static_cast<int64_t*>(domainPacket.getRawData());
+        for (size_t i = 0; i < messagesCount; ++i)
+        {
+            canData[i].arbId = static_cast<uint32_t>(i % 0x800);
+            canData[i].length = 8;
+            std::fill(std::begin(canData[i].data), std::end(canData[i].data), static_cast<uint8_t>(i));
+            timeBuffer[i] = static_cast<int64_t>(i) * 100;
+        }
+
+        return dataPacket;
+    }
+
+    // Waits until no frame has been sent for a while and returns the number of data frames sent so far
+    size_t waitForIdle()
+    {
+        size_t frames;
+        do
+        {
+            frames = sentDataFrames;
+            std::this_thread::sleep_for(200ms);
+        } while (frames != sentDataFrames);
+
+        return frames;
+    }
+
+    bool waitForFrames(size_t framesCount)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (sentDataFrames < framesCount && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(1ms);
+
+        return sentDataFrames >= framesCount;
+    }
+
+protected:
+    std::shared_ptr<NiceMock<asam_cmp_common_lib::EthernetPcppMock>> ethernetWrapper;
+    ListPtr<StringPtr> names{"device1"};
+    ListPtr<StringPtr> descriptions{"description1"};
+    ContextPtr context;
+    FunctionBlockPtr captureFb;
+    FunctionBlockPtr streamFb;
+    SignalConfigPtr valueSignal;
+    SignalConfigPtr timeSignal;
+    std::atomic<size_t> sentDataFrames{0};
+};
+
+TEST_F(HotPathAllocationsTest, ProcessCanPacket)
+{
+    SKIP_IF_ALLOCATIONS_NOT_COUNTED();
+
+    constexpr size_t messagesPerPacket = 100;
+    constexpr size_t warmUpPackets = 10;
+    constexpr size_t packetsCount = 100;
+
+    streamFb.getInputPorts().getItemAt(0).connect(valueSignal);
+    const auto packet = createCanPacket(messagesPerPacket);
+
+    for (size_t i = 0; i < warmUpPackets; ++i)
+        valueSignal.sendPacket(packet);
+    const size_t warmUpFrames = waitForIdle();
+    ASSERT_GT(warmUpFrames, 0u);
+    ASSERT_EQ(warmUpFrames % warmUpPackets, 0u);
+    const size_t framesPerPacket = warmUpFrames / warmUpPackets;
+
+    AllocationStatistics statistics;
+    {
+        AllocationCounter counter;
+        for (size_t i = 0; i < packetsCount; ++i)
+            valueSignal.sendPacket(packet);
+        ASSERT_TRUE(waitForFrames(warmUpFrames + packetsCount * framesPerPacket));
+        statistics = counter.getStatistics();
+    }
+
+    // Every message still builds an ASAM CMP packet and payload; the budget catches anything added on top
+    expectAllocationBudget(statistics, packetsCount * messagesPerPacket, 8, 1024);
+}
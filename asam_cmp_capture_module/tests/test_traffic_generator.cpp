@@ -0,0 +1,222 @@
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_capture_module/traffic_generator.h>
+#include <asam_cmp_capture_module/traffic_generator_fb.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp/can_payload.h>
+#include <asam_cmp/decoder.h>
+#include <map>
+#include <set>
+#include <thread>
+
+using namespace daq;
+using namespace testing;
+using modules::asam_cmp_capture_module::CanIdDistribution;
+using modules::asam_cmp_capture_module::GeneratorPayloadType;
+using modules::asam_cmp_capture_module::TrafficGenerator;
+using modules::asam_cmp_capture_module::TrafficGeneratorConfig;
+
+class TrafficGeneratorTest : public testing::Test
+{
+protected:
+    TrafficGeneratorTest()
+        : ethernetWrapper(std::make_shared<NiceMock<asam_cmp_common_lib::EthernetPcppMock>>())
+    {
+        ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(List<IString>("device1")));
+        ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(List<IString>("device1")));
+        ON_CALL(*ethernetWrapper, setDevice(_)).WillByDefault(Return(true));
+        ON_CALL(*ethernetWrapper, sendPacket(_))
+            .WillByDefault(WithArgs<0>(Invoke([this](const std::vector<uint8_t>& data) { onPacketSendCb(data); })));
+    }
+
+    void onPacketSendCb(const std::vector<uint8_t>& data)
+    {
+        std::scoped_lock lock(packetsSync);
+        ++sentFrames;
+        for (const auto& packet : decoder.decode(data.data(), data.size()))
+            receivedPackets.push_back(packet);
+    }
+
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> getPackets(ASAM::CMP::CmpHeader::MessageType messageType)
+    {
+        std::vector<std::shared_ptr<ASAM::CMP::Packet>> packets;
+        for (const auto& packet : receivedPackets)
+            if (packet->getMessageType() == messageType)
+                packets.push_back(packet);
+        return packets;
+    }
+
+protected:
+    static constexpr uint64_t nsInSec = 1'000'000'000;
+
+    std::shared_ptr<NiceMock<asam_cmp_common_lib::EthernetPcppMock>> ethernetWrapper;
+    std::mutex packetsSync;
+    ASAM::CMP::Decoder decoder;
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> receivedPackets;
+    size_t sentFrames{0};
+};
+
+TEST_F(TrafficGeneratorTest, StatusMessages)
+{
+    TrafficGeneratorConfig config;
+    config.deviceCount = 2;
+    config.interfacesPerDevice = 3;
+    config.messageRate = 0;
+
+    TrafficGenerator generator(config, ethernetWrapper);
+    generator.step(nsInSec);
+
+    auto statusPackets = getPackets(ASAM::CMP::CmpHeader::MessageType::status);
+    ASSERT_EQ(statusPackets.size(), config.deviceCount * (1 + config.interfacesPerDevice));
+
+    size_t captureStatusCount = 0;
+    std::set<uint16_t> deviceIds;
+    for (const auto& packet : statusPackets)
+    {
+        deviceIds.insert(packet->getDeviceId());
+        if (packet->getPayload().getType() == ASAM::CMP::PayloadType::cmStatMsg)
+            ++captureStatusCount;
+    }
+    ASSERT_EQ(captureStatusCount, config.deviceCount);
+    ASSERT_EQ(deviceIds, (std::set<uint16_t>{config.firstDeviceId, static_cast<uint16_t>(config.firstDeviceId + 1)}));
+
+    receivedPackets.clear();
+    generator.step(nsInSec + nsInSec / 2);
+    ASSERT_TRUE(getPackets(ASAM::CMP::CmpHeader::MessageType::status).empty());
+
+    generator.step(2 * nsInSec);
+    ASSERT_EQ(getPackets(ASAM::CMP::CmpHeader::MessageType::status).size(), statusPackets.size());
+}
+
+TEST_F(TrafficGeneratorTest, MessageRate)
+{
+    TrafficGeneratorConfig config;
+    config.interfacesPerDevice = 2;
+    config.streamsPerInterface = 2;
+    config.messageRate = 1000;
+    config.statusPeriod = std::chrono::milliseconds(0);
+
+    TrafficGenerator generator(config, ethernetWrapper);
+    for (uint64_t time = nsInSec; time < 2 * nsInSec; time += nsInSec / 100)
+        generator.step(time);
+
+    const size_t streamCount = config.interfacesPerDevice * config.streamsPerInterface;
+    const size_t expectedMessages = 991 * streamCount;
+    ASSERT_EQ(generator.getSentMessages(), expectedMessages);
+    ASSERT_EQ(generator.getSentFrames(), sentFrames);
+
+    auto dataPackets = getPackets(ASAM::CMP::CmpHeader::MessageType::data);
+    ASSERT_EQ(dataPackets.size(), expectedMessages);
+
+    std::set<std::pair<uint32_t, uint8_t>> streams;
+    for (const auto& packet : dataPackets)
+    {
+        ASSERT_EQ(packet->getPayload().getType(), ASAM::CMP::PayloadType::can);
+        streams.emplace(packet->getInterfaceId(), packet->getStreamId());
+    }
+    ASSERT_EQ(streams.size(), streamCount);
+}
+
+TEST_F(TrafficGeneratorTest, MessageRateSpread)
+{
+    TrafficGeneratorConfig config;
+    config.streamsPerInterface = 3;
+    config.messageRate = 1000;
+    config.messageRateSpread = 0.5;
+    config.statusPeriod = std::chrono::milliseconds(0);
+
+    TrafficGenerator generator(config, ethernetWrapper);
+    for (uint64_t time = nsInSec; time < 2 * nsInSec; time += nsInSec / 100)
+        generator.step(time);
+
+    std::map<uint8_t, size_t> streamMessages;
+    for (const auto& packet : getPackets(ASAM::CMP::CmpHeader::MessageType::data))
+        ++streamMessages[packet->getStreamId()];
+
+    ASSERT_EQ(streamMessages, (std::map<uint8_t, size_t>{{1, 496}, {2, 991}, {3, 1486}}));
+    ASSERT_EQ(generator.getSentMessages(), 496 + 991 + 1486);
+}
+
+TEST_F(TrafficGeneratorTest, BurstPeriod)
+{
+    TrafficGeneratorConfig config;
+    config.messageRate = 1000;
+    config.burstPeriod = std::chrono::milliseconds(100);
+    config.statusPeriod = std::chrono::milliseconds(0);
+
+    TrafficGenerator generator(config, ethernetWrapper);
+    generator.step(nsInSec);
+    const auto firstBurst = generator.getSentMessages();
+
+    for (uint64_t time = nsInSec + nsInSec / 1000; time < nsInSec + nsInSec / 10; time += nsInSec / 1000)
+        generator.step(time);
+    ASSERT_EQ(generator.getSentMessages(), firstBurst);
+
+    generator.step(nsInSec + nsInSec / 10);
+    ASSERT_EQ(generator.getSentMessages(), firstBurst + 100);
+}
+
+TEST_F(TrafficGeneratorTest, SequentialCanIds)
+{
+    TrafficGeneratorConfig config;
+    config.messageRate = 1000;
+    config.canIdCount = 4;
+    config.canIdDistribution = CanIdDistribution::sequential;
+    config.statusPeriod = std::chrono::milliseconds(0);
+
+    TrafficGenerator generator(config, ethernetWrapper);
+    generator.step(nsInSec);
+    generator.step(nsInSec + nsInSec / 100);
+
+    auto dataPackets = getPackets(ASAM::CMP::CmpHeader::MessageType::data);
+    ASSERT_EQ(dataPackets.size(), 11u);
+    for (size_t i = 0; i < dataPackets.size(); ++i)
+    {
+        const auto& payload = static_cast<const ASAM::CMP::CanPayload&>(dataPackets[i]->getPayload());
+        ASSERT_EQ(payload.getId(), i % config.canIdCount);
+        ASSERT_EQ(payload.getDataLength(), config.canDataLength);
+    }
+}
+
+TEST_F(TrafficGeneratorTest, MixedPayloadTypes)
+{
+    ASSERT_EQ(TrafficGenerator::getInterfacePayloadType(GeneratorPayloadType::mixed, 0), GeneratorPayloadType::can);
+    ASSERT_EQ(TrafficGenerator::getInterfacePayloadType(GeneratorPayloadType::mixed, 1), GeneratorPayloadType::canFd);
+    ASSERT_EQ(TrafficGenerator::getInterfacePayloadType(GeneratorPayloadType::mixed, 2), GeneratorPayloadType::analog);
+    ASSERT_EQ(TrafficGenerator::getInterfacePayloadType(GeneratorPayloadType::mixed, 3), GeneratorPayloadType::can);
+    ASSERT_EQ(TrafficGenerator::getInterfacePayloadType(GeneratorPayloadType::analog, 0), GeneratorPayloadType::analog);
+
+    TrafficGeneratorConfig config;
+    config.payloadType = GeneratorPayloadType::mixed;
+    config.interfacesPerDevice = 3;
+    config.statusPeriod = std::chrono::milliseconds(0);
+
+    TrafficGenerator generator(config, ethernetWrapper);
+    generator.step(nsInSec);
+
+    std::set<int> types;
+    for (const auto& packet : getPackets(ASAM::CMP::CmpHeader::MessageType::data))
+        types.insert(static_cast<int>(packet->getPayload().getType()));
+    ASSERT_EQ(types.size(), 3u);
+}
+
+TEST_F(TrafficGeneratorTest, FunctionBlockSendsTraffic)
+{
+    auto logger = Logger();
+    auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+    auto fb = createWithImplementation<IFunctionBlock, modules::asam_cmp_capture_module::TrafficGeneratorFb>(
+        context, nullptr, "asam_cmp_traffic_generator", ethernetWrapper);
+
+    ASSERT_EQ(fb.getPropertyValue("SentMessages"), 0);
+    fb.setPropertyValue("MessageRate", 10000.0);
+    fb.setPropertyValue("Enabled", True);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    fb.setPropertyValue("Enabled", False);
+
+    const Int sentMessages = fb.getPropertyValue("SentMessages");
+    ASSERT_GT(sentMessages, 0);
+    ASSERT_EQ(fb.getPropertyValue("SentMessages"), sentMessages);
+}
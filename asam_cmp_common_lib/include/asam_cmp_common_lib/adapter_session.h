@@ -0,0 +1,146 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <PcapFilter.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// One opened network adapter shared by every capture module and data sink of the process. Frames of all senders go
+// through a single transmit queue drained by one thread. One live capture receives the frames passing the union of the
+// receivers' filters, each frame is delivered only to the receivers whose own filter it matches.
+class AdapterSession final
+{
+public:
+    AdapterSession(pcpp::PcapLiveDevice* device, const CaptureConfiguration& configuration);
+    ~AdapterSession();
+
+    AdapterSession(const AdapterSession&) = delete;
+    AdapterSession& operator=(const AdapterSession&) = delete;
+
+    pcpp::PcapLiveDevice* getDevice() const;
+    bool open();
+    // Reopens the adapter with the new buffer size, snapshot length and read timeout. Returns false and keeps the
+    // current settings while receivers are registered, as reopening would restart their capture.
+    bool setConfiguration(const CaptureConfiguration& configuration);
+
+    // Copies the CMP frame into the transmit queue, blocks while the queue is full
+    void send(const std::vector<uint8_t>& data);
+
+    // Locally originated frames are the ones with the adapter's own source MAC address. A filter that doesn't compile
+    // is treated as empty, the receiver gets all CMP frames then.
+    size_t addReceiver(PcppPacketReceivedCallbackType callback, const std::string& filter, bool suppressLocalFrames);
+    // Returns false if the combined filter can't be applied and the adapter captures all CMP frames
+    bool setReceiverFilter(size_t receiverId, const std::string& filter);
+    // After return the callback of the receiver is not running and won't be called again. Called from the receiver's own
+    // callback, it only guarantees the latter.
+    void removeReceiver(size_t receiverId);
+    // Sampled on the capture thread while frames arrive, so the values may be up to statisticsPeriod old
+    CaptureStatistics getStatistics() const;
+
+public:
+    static constexpr size_t txQueueSize = 256;
+    static constexpr size_t ethHeaderSize = 14;
+    static constexpr std::chrono::milliseconds statisticsPeriod{100};
+
+private:
+    // Callbacks run without any session lock held, removal waits only for the callbacks of the removed receiver
+    struct ReceiverState
+    {
+        std::atomic<size_t> activeCallbacks{0};
+        std::atomic<bool> removed{false};
+    };
+
+    struct Receiver
+    {
+        PcppPacketReceivedCallbackType callback;
+        std::string filter;
+        // Not set for an empty or invalid filter. Matching happens on the capture thread only.
+        std::shared_ptr<pcpp::BpfFilterWrapper> bpfFilter;
+        bool suppressLocalFrames;
+        std::shared_ptr<ReceiverState> state;
+    };
+    using Receivers = std::unordered_map<size_t, Receiver>;
+
+    void txLoop();
+    void startCapture();
+    void stopCapture();
+    std::shared_ptr<const Receivers> getReceivers() const;
+    void setReceivers(std::shared_ptr<const Receivers> newReceivers);
+    std::string getCombinedFilter() const;
+    void onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie);
+    static std::shared_ptr<pcpp::BpfFilterWrapper> createBpfFilter(const std::string& filter);
+    bool isLocalFrame(const pcpp::RawPacket* packet) const;
+    void updateStatistics();
+    pcpp::PcapLiveDevice::DeviceConfiguration getDeviceConfiguration() const;
+
+private:
+    pcpp::PcapLiveDevice* const device;
+    std::array<uint8_t, 6> macAddress{};
+
+    std::mutex deviceSync;
+    CaptureConfiguration configuration;
+
+    // Receivers are replaced as a whole, so changing them never waits for a dispatch in progress
+    mutable std::mutex receiversSync;
+    std::shared_ptr<const Receivers> receivers;
+    size_t nextReceiverId{0};
+    // A receiver removing itself from its callback must not wait for that callback to return
+    std::atomic<std::thread::id> captureThreadId;
+
+    // pcap_stats is not called concurrently with the capture on the handle, the capture thread publishes its samples
+    mutable std::mutex statisticsSync;
+    CaptureStatistics statistics;
+    std::chrono::steady_clock::time_point nextStatisticsUpdate;
+
+    std::mutex txSync;
+    std::condition_variable txNotEmpty;
+    std::condition_variable txNotFull;
+    std::array<std::vector<uint8_t>, txQueueSize> txQueue;
+    size_t txHead{0};
+    size_t txCount{0};
+    bool txStop{false};
+    std::thread txThread;
+};
+
+// Process-wide registry handing out one reference counted session per adapter
+class AdapterSessionRegistry final
+{
+public:
+    static AdapterSessionRegistry& getInstance();
+
+    std::shared_ptr<AdapterSession> acquire(pcpp::PcapLiveDevice* device, const CaptureConfiguration& configuration);
+
+private:
+    void release(AdapterSession* session);
+
+private:
+    std::mutex sync;
+    std::condition_variable sessionReleased;
+    std::unordered_map<pcpp::PcapLiveDevice*, std::weak_ptr<AdapterSession>> sessions;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
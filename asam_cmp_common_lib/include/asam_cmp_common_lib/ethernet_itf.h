@@ -33,6 +33,13 @@ struct is_callable
     static const bool value = std::is_function<T>::value || std::is_member_function_pointer<T>::value || decltype(test<T>(nullptr))::value;
 };
 
+struct CaptureStatistics
+{
+    uint64_t received{0};
+    uint64_t droppedByKernel{0};
+    uint64_t droppedByInterface{0};
+};
+
 template <typename OnPacketReceivedCallbackType>
 class EthernetItf
 {
@@ -47,6 +54,11 @@ public:
     virtual void stopCapture() = 0;
     virtual bool isDeviceCapturing() const = 0;
     virtual bool setDevice(const StringPtr& deviceName) = 0;
+    // The adapter actually used, which differs from the default one if that couldn't be opened on first use
+    virtual StringPtr getActiveDeviceName() const = 0;
+    // Returns false if the filter can't be applied, all ASAM CMP frames are captured then
+    virtual bool setCaptureFilter(const std::string& filter) = 0;
+    virtual CaptureStatistics getCaptureStatistics() const = 0;
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
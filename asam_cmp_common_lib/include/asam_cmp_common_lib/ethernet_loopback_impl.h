@@ -0,0 +1,76 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// In-process backend: frames sent with sendPacket() are delivered to the capture callback from a separate thread,
+// as if they went through a network adapter. Capture filters are accepted but not applied.
+class EthernetLoopbackImpl final : public EthernetPcppItf
+{
+public:
+    explicit EthernetLoopbackImpl(size_t queueCapacity = defaultQueueCapacity);
+    ~EthernetLoopbackImpl() override;
+
+    ListPtr<StringPtr> getEthernetDevicesNamesList() override;
+    ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
+    void sendPacket(const std::vector<uint8_t>& data) override;
+    void startCapture(PcppPacketReceivedCallbackType packetReceivedCb) override;
+    void stopCapture() override;
+    bool isDeviceCapturing() const override;
+    bool setDevice(const StringPtr& name) override;
+    StringPtr getActiveDeviceName() const override;
+    bool setCaptureFilter(const std::string& filter) override;
+    CaptureStatistics getCaptureStatistics() const override;
+    void startBatchCapture(PcppPacketsReceivedCallbackType packetsReceivedCb) override;
+    bool setCaptureConfiguration(const CaptureConfiguration& configuration) override;
+
+public:
+    static constexpr const char* deviceName = "loopback";
+    static constexpr size_t defaultQueueCapacity = 65536;
+
+private:
+    struct Frame
+    {
+        std::vector<uint8_t> data;
+        timespec timestamp;
+    };
+
+    void startDelivery(PcppPacketReceivedCallbackType packetReceivedCb, PcppPacketsReceivedCallbackType packetsReceivedCb);
+    void deliveryLoop(PcppPacketReceivedCallbackType packetReceivedCb, PcppPacketsReceivedCallbackType packetsReceivedCb);
+
+private:
+    const size_t queueCapacity;
+
+    mutable std::mutex queueSync;
+    std::condition_variable queueCv;
+    std::deque<Frame> queue;
+    bool capturing{false};
+    uint64_t received{0};
+    uint64_t dropped{0};
+    size_t batchSize{CaptureConfiguration{}.batchSize};
+
+    std::thread deliveryThread;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
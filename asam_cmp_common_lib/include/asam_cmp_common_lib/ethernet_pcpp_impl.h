@@ -15,7 +15,12 @@
  */
 
 #pragma once
+#include <asam_cmp_common_lib/adapter_session.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_common_lib/pcap_batch_capture.h>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
@@ -23,6 +28,7 @@ class EthernetPcppImpl : public EthernetPcppItf
 {
 public:
     EthernetPcppImpl();
+    ~EthernetPcppImpl() override;
     ListPtr<StringPtr> getEthernetDevicesNamesList() override;
     ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
     void sendPacket(const std::vector<uint8_t>& data) override;
@@ -30,11 +36,20 @@ public:
     void stopCapture() override;
     bool isDeviceCapturing() const override;
     bool setDevice(const StringPtr& deviceName) override;
+    StringPtr getActiveDeviceName() const override;
+    bool setCaptureFilter(const std::string& filter) override;
+    CaptureStatistics getCaptureStatistics() const override;
+    void startBatchCapture(PcppPacketsReceivedCallbackType packetsReceivedCb) override;
+    bool setCaptureConfiguration(const CaptureConfiguration& configuration) override;
 
 private:
     std::vector<pcpp::PcapLiveDevice*> createAvailableDevicesList() const;
-    pcpp::PcapLiveDevice* getFirstAvailableDevice() const;
-    pcpp::PcapLiveDevice* getPcapLiveDevice(const StringPtr& deviceName) const;
+    // Called with captureSync locked
+    std::shared_ptr<AdapterSession> getOpenedSession(pcpp::PcapLiveDevice* device);
+    // Called with captureSync locked
+    std::shared_ptr<AdapterSession> getActiveSession();
+    std::string getBpfFilter() const;
+    void stopCaptureInternal();
 
 public:
     static constexpr uint16_t asamCmpEtherType = 0x99FE;
@@ -42,7 +57,23 @@ public:
 private:
     pcpp::PcapLiveDeviceList& pcapDeviceList{pcpp::PcapLiveDeviceList::getInstance()};
     const std::vector<pcpp::PcapLiveDevice*> deviceList;
+
+    // Guards the capture state below. Filters are updated from subscription handlers while capture is started and
+    // stopped on the FB thread. It is locked before sessionsSync.
+    mutable std::mutex captureSync;
+    CaptureConfiguration captureConfiguration;
     pcpp::PcapLiveDevice* activeDevice;
+    // Until an adapter is selected or opened, a default adapter that can't be opened falls through to the next one
+    bool deviceResolved{false};
+    std::shared_ptr<AdapterSession> receivingSession;
+    std::optional<size_t> receiverId;
+    std::string captureFilter;
+    std::unique_ptr<PcapBatchCapture> batchCapture;
+
+    std::mutex sessionsSync;
+    // Adapters stay open while some module holds their session, so selecting an adapter again doesn't reopen it
+    std::unordered_map<pcpp::PcapLiveDevice*, std::shared_ptr<AdapterSession>> sessions;
+    std::shared_ptr<AdapterSession> activeSession;
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
@@ -22,6 +22,25 @@
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
 using PcppPacketReceivedCallbackType = std::function<void(pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*)>;
+using PcppPacketsReceivedCallbackType = std::function<void(const std::vector<pcpp::RawPacket*>&)>;
+
+enum class CaptureMode
+{
+    perPacket,
+    batch
+};
+
+// Zero values keep the libpcap defaults
+struct CaptureConfiguration
+{
+    int bufferSize{0};
+    int snapshotLength{0};
+    int readTimeout{0};
+    bool immediateMode{true};
+    int batchSize{64};
+    bool suppressLocalFrames{false};
+};
+
 class EthernetPcppItf: public EthernetItf<PcppPacketReceivedCallbackType>
 {
     public:
@@ -34,6 +53,14 @@ class EthernetPcppItf: public EthernetItf<PcppPacketReceivedCallbackType>
     void stopCapture() override = 0;
     bool isDeviceCapturing() const override = 0;
     bool setDevice(const StringPtr& deviceName) override = 0;
+    StringPtr getActiveDeviceName() const override = 0;
+    bool setCaptureFilter(const std::string& filter) override = 0;
+    CaptureStatistics getCaptureStatistics() const override = 0;
+
+    virtual void startBatchCapture(PcppPacketsReceivedCallbackType packetsReceivedCb) = 0;
+    // Adapter-wide settings are shared by all modules using the adapter. Returns false if they are kept because other
+    // modules capture from it; per-module settings (batch capture, local frame suppression) are applied anyway.
+    virtual bool setCaptureConfiguration(const CaptureConfiguration& configuration) = 0;
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
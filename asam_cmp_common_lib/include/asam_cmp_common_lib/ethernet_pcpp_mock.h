@@ -33,6 +33,11 @@ public:
     MOCK_METHOD(void, stopCapture, (), (override));
     MOCK_METHOD(bool, isDeviceCapturing, (), (const, override));
     MOCK_METHOD(bool, setDevice, (const StringPtr& deviceName), (override));
+    MOCK_METHOD(StringPtr, getActiveDeviceName, (), (const, override));
+    MOCK_METHOD(bool, setCaptureFilter, (const std::string& filter), (override));
+    MOCK_METHOD(CaptureStatistics, getCaptureStatistics, (), (const, override));
+    MOCK_METHOD(void, startBatchCapture, (PcppPacketsReceivedCallbackType packetsReceivedCb), (override));
+    MOCK_METHOD(bool, setCaptureConfiguration, (const CaptureConfiguration& configuration), (override));
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
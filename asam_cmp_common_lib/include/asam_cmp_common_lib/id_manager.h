@@ -16,62 +16,214 @@
 
 #pragma once
 #include <asam_cmp_common_lib/common.h>
-#include <set>
-#include <unordered_set>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
+// Hierarchical bitmap of free ids for small id spaces. A bit of an upper level is set while the word below it has a free id,
+// so the first free id is found with one word per level.
 template <typename T>
-class IdManager
+class FreeIdsBitmap
 {
 public:
-    T getFirstUnusedId()
+    FreeIdsBitmap()
     {
-        return (unusedIds.empty() ? getMinUnusedId() : *(unusedIds.begin()));
+        for (size_t bitsCount = idsCount; bitsCount > 1 || levels.empty(); bitsCount = (bitsCount + wordBits - 1) / wordBits)
+        {
+            std::vector<uint64_t> level((bitsCount + wordBits - 1) / wordBits, ~uint64_t{0});
+            if (bitsCount % wordBits != 0)
+                level.back() = (uint64_t{1} << (bitsCount % wordBits)) - 1;
+            levels.push_back(std::move(level));
+        }
     }
 
-    bool isValidId(int64_t arg)
+    bool isFree(T id) const
     {
-        return (arg >= 0 && arg <= std::numeric_limits<T>::max() && usedIds.count(arg) == 0);
+        return (levels.front()[id / wordBits] >> (id % wordBits)) & 1;
     }
 
-    void addId(T id)
+    void setUsed(T id)
     {
-        if (isValidId(id))
+        size_t pos = id;
+        for (auto& level : levels)
         {
-            if (unusedIds.count(id))
-                unusedIds.erase(id);
+            auto& word = level[pos / wordBits];
+            word &= ~(uint64_t{1} << (pos % wordBits));
+            if (word != 0)
+                break;
+            pos /= wordBits;
+        }
+    }
 
-            usedIds.insert(id);
+    void setFree(T id)
+    {
+        size_t pos = id;
+        for (auto& level : levels)
+        {
+            auto& word = level[pos / wordBits];
+            const bool hadFreeIds = word != 0;
+            word |= uint64_t{1} << (pos % wordBits);
+            if (hadFreeIds)
+                break;
+            pos /= wordBits;
         }
     }
 
-    void removeId(T id)
+    std::optional<T> findFree(T from) const
     {
-        if (usedIds.count(id))
+        // Climb until a word has a free bit at or after the position, then descend to the leftmost free leaf
+        size_t level = 0;
+        size_t pos = from;
+        for (; level < levels.size(); ++level)
         {
-            unusedIds.insert(id);
-            usedIds.erase(id);
+            const size_t wordIndex = pos / wordBits;
+            if (wordIndex >= levels[level].size())
+                return std::nullopt;
+
+            const uint64_t bits = levels[level][wordIndex] & (~uint64_t{0} << (pos % wordBits));
+            if (bits != 0)
+            {
+                pos = wordIndex * wordBits + countTrailingZeros(bits);
+                break;
+            }
+            pos = wordIndex + 1;
         }
+
+        if (level == levels.size())
+            return std::nullopt;
+
+        while (level-- > 0)
+            pos = pos * wordBits + countTrailingZeros(levels[level][pos]);
+
+        return static_cast<T>(pos);
     }
 
 private:
-    T getMinUnusedId() const
+    static size_t countTrailingZeros(uint64_t value)
     {
-        T result = 1;
-        for (const auto& e : usedIds)
-            result += (result == e);
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return index;
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    static constexpr size_t wordBits = 64;
+    static constexpr size_t idsCount = size_t{std::numeric_limits<T>::max()} + 1;
 
-        return result;
+    std::vector<std::vector<uint64_t>> levels;
+};
+
+// Ordered map of free id intervals for large id spaces, memory grows with the number of gaps instead of the number of ids
+template <typename T>
+class FreeIdsIntervals
+{
+public:
+    bool isFree(T id) const
+    {
+        auto it = freeIntervals.upper_bound(id);
+        return it != freeIntervals.begin() && id <= std::prev(it)->second;
     }
 
-    std::set<T> usedIds;
-    std::unordered_set<T> unusedIds;
+    void setUsed(T id)
+    {
+        auto it = std::prev(freeIntervals.upper_bound(id));
+        const T first = it->first;
+        const T last = it->second;
+
+        freeIntervals.erase(it);
+        if (first < id)
+            freeIntervals.emplace(first, static_cast<T>(id - 1));
+        if (id < last)
+            freeIntervals.emplace(static_cast<T>(id + 1), last);
+    }
+
+    void setFree(T id)
+    {
+        auto next = freeIntervals.upper_bound(id);
+        T first = id;
+        T last = id;
+
+        if (next != freeIntervals.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->second + 1 == id)
+            {
+                first = prev->first;
+                freeIntervals.erase(prev);
+            }
+        }
+        if (next != freeIntervals.end() && next->first == id + 1)
+        {
+            last = next->second;
+            freeIntervals.erase(next);
+        }
+
+        freeIntervals.emplace(first, last);
+    }
+
+    std::optional<T> findFree(T from) const
+    {
+        auto it = freeIntervals.upper_bound(from);
+        if (it != freeIntervals.begin() && from <= std::prev(it)->second)
+            return from;
+        if (it != freeIntervals.end())
+            return it->first;
+
+        return std::nullopt;
+    }
+
+private:
+    std::map<T, T> freeIntervals{{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()}};
+};
+
+template <typename T>
+class IdManager
+{
+public:
+    // Id 0 is only taken when it is set explicitly, 0 is also returned when all other ids are used
+    T getFirstUnusedId() const
+    {
+        return freeIds.findFree(1).value_or(0);
+    }
+
+    bool isValidId(int64_t arg) const
+    {
+        return (arg >= 0 && arg <= std::numeric_limits<T>::max() && freeIds.isFree(static_cast<T>(arg)));
+    }
+
+    void addId(T id)
+    {
+        if (freeIds.isFree(id))
+            freeIds.setUsed(id);
+    }
+
+    void removeId(T id)
+    {
+        if (!freeIds.isFree(id))
+            freeIds.setFree(id);
+    }
+
+private:
+    std::conditional_t<(sizeof(T) <= sizeof(uint16_t)), FreeIdsBitmap<T>, FreeIdsIntervals<T>> freeIds;
 };
 
 using InterfaceIdManager = IdManager<uint32_t>;
 using StreamIdManager = IdManager<uint8_t>;
+using DeviceIdManager = IdManager<uint16_t>;
 using InterfaceIdManagerPtr = InterfaceIdManager*;
 using StreamIdManagerPtr = StreamIdManager*;
+using DeviceIdManagerPtr = DeviceIdManager*;
 
 END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <coreobjects/property_object_ptr.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+
+#include <asam_cmp_common_lib/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Log-linear histogram of nanosecond values with 16 sub-buckets per power of two (about 6% relative error).
+// record() is a relaxed atomic increment and can be called from any number of threads.
+class LatencyHistogram final
+{
+public:
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t getCount() const;
+    uint64_t getMax() const;
+    uint64_t getPercentile(double percentile) const;
+
+public:
+    static constexpr size_t linearBucketsCount = 32;
+    static constexpr size_t subBucketBits = 4;
+    static constexpr size_t bucketsCount = linearBucketsCount + (64 - 5) * (size_t{1} << subBucketBits);
+
+    static size_t getBucketIndex(uint64_t value);
+    static uint64_t getBucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, bucketsCount> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> max{0};
+};
+
+enum class LatencyStage
+{
+    dequeue,
+    encode,
+    send,
+    kernelRx,
+    decode,
+    publish,
+    packetCreation,
+    count
+};
+
+// Process-wide set of stage histograms, the stages are recorded without knowing the module FB they belong to
+class LatencyStatistics final
+{
+public:
+    static LatencyStatistics& getInstance();
+
+    LatencyHistogram& getHistogram(LatencyStage stage);
+    static const char* getStageName(LatencyStage stage);
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyStage::count)> histograms;
+};
+
+class LatencyScope final
+{
+public:
+    explicit LatencyScope(LatencyStage stage)
+        : histogram(LatencyStatistics::getInstance().getHistogram(stage))
+        , startTime(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~LatencyScope()
+    {
+        histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+    }
+
+    LatencyScope(const LatencyScope&) = delete;
+    LatencyScope& operator=(const LatencyScope&) = delete;
+
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+// Adds read-only <Stage>LatencyP50, P99, P999 and Max properties in nanoseconds and a ResetLatency procedure.
+// The properties read the process-wide histograms, ResetLatency clears the given stages for every object exposing them.
+void addLatencyProperties(PropertyObjectPtr obj, std::initializer_list<LatencyStage> stages);
+
+END_NAMESPACE_ASAM_CMP_COMMON
+
+#define ASAM_CMP_LATENCY_CONCAT_IMPL(a, b) a##b
+#define ASAM_CMP_LATENCY_CONCAT(a, b) ASAM_CMP_LATENCY_CONCAT_IMPL(a, b)
+
+#ifdef ASAM_CMP_ENABLE_LATENCY_HISTOGRAMS
+#define ASAM_CMP_LATENCY_SCOPE(stage) \
+    ::daq::asam_cmp_common_lib::LatencyScope ASAM_CMP_LATENCY_CONCAT(latencyScope, __LINE__)(::daq::asam_cmp_common_lib::LatencyStage::stage)
+#define ASAM_CMP_LATENCY_RECORD(stage, value) \
+    ::daq::asam_cmp_common_lib::LatencyStatistics::getInstance().getHistogram(::daq::asam_cmp_common_lib::LatencyStage::stage).record(value)
+#else
+#define ASAM_CMP_LATENCY_SCOPE(stage)
+#define ASAM_CMP_LATENCY_RECORD(stage, value)
+#endif
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <asam_cmp_common_lib/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Latency probes are vendor-defined CMP messages carrying the sender wall-clock time in ns since the Unix epoch.
+// Receivers that do not know them drop them as an unsupported message type.
+struct LatencyProbe
+{
+    uint16_t deviceId{0};
+    uint16_t sequenceCounter{0};
+    uint64_t txTime{0};
+};
+
+constexpr uint8_t latencyProbeMessageType = 0xFF;
+constexpr uint16_t latencyProbeVendorId = 0xFFFF;
+constexpr size_t latencyProbeSize = 22;
+
+std::vector<uint8_t> encodeLatencyProbe(const LatencyProbe& probe);
+bool decodeLatencyProbe(const uint8_t* data, size_t size, LatencyProbe& probe);
+
+END_NAMESPACE_ASAM_CMP_COMMON
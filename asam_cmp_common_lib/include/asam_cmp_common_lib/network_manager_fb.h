@@ -17,11 +17,10 @@
 #pragma once
 #include <opendaq/function_block_impl.h>
 #include <asam_cmp_common_lib/common.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
-class EthernetPcppItf;
-
 class NetworkManagerFb : public FunctionBlock
 {
 public:
@@ -35,9 +34,13 @@ public:
 private:
     void initProperties();
     void addNetworkAdaptersProperty();
+    // -1 if the wrapper has no adapter or one missing from the list
+    Int getActiveAdapterIndex(const ListPtr<StringPtr>& devicesNames) const;
 
 protected:
     virtual void networkAdapterChangedInternal() = 0;
+    // Follows the wrapper to the adapter it fell back to when the default one couldn't be opened
+    void updateSelectedAdapterName();
 
 protected:
     std::shared_ptr<EthernetPcppItf> ethernetWrapper;
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <RawPacket.h>
+#include <pcap.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Captures on its own libpcap handle and drains up to batchSize packets per pcap_dispatch call. Packets of one
+// batch are copied into a reusable arena and delivered together; the raw packets are valid only during the callback.
+class PcapBatchCapture final
+{
+public:
+    PcapBatchCapture(const std::string& deviceName,
+                     const CaptureConfiguration& configuration,
+                     const std::string& filter,
+                     PcppPacketsReceivedCallbackType packetsReceivedCb);
+    ~PcapBatchCapture();
+
+    PcapBatchCapture(const PcapBatchCapture&) = delete;
+    PcapBatchCapture& operator=(const PcapBatchCapture&) = delete;
+
+    void setFilter(const std::string& filter);
+    // Sampled on the capture thread, so the values may be up to statisticsPeriod old
+    CaptureStatistics getStatistics() const;
+
+public:
+    static constexpr int defaultReadTimeout = 10;
+    static constexpr std::chrono::milliseconds statisticsPeriod{100};
+
+private:
+    void run();
+    void applyFilter(const std::string& filter);
+    bool compileFilter(const std::string& filter);
+    void updateStatistics();
+    void deliverBatch();
+    static void onPacket(u_char* user, const pcap_pkthdr* header, const u_char* data);
+
+private:
+    pcap_t* handle{nullptr};
+    int batchSize;
+    PcppPacketsReceivedCallbackType packetsReceivedCb;
+
+    std::mutex filterSync;
+    std::string pendingFilter;
+    bool filterChanged{false};
+    // pcap_stats is not called concurrently with pcap_dispatch on the handle, the capture thread publishes its samples
+    mutable std::mutex statisticsSync;
+    CaptureStatistics statistics;
+    std::chrono::steady_clock::time_point nextStatisticsUpdate;
+
+    std::vector<uint8_t> arena;
+    std::vector<std::pair<pcap_pkthdr, size_t>> headers;
+    std::vector<pcpp::RawPacket> rawPackets;
+    std::vector<pcpp::RawPacket*> batch;
+
+    std::atomic_bool running{true};
+    std::thread captureThread;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <coreobjects/property_object_ptr.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include <asam_cmp_common_lib/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+enum class TraceEventType : uint8_t
+{
+    begin,
+    end,
+    counter
+};
+
+// Event names must be string literals, only the pointer is stored
+struct TraceEvent
+{
+    const char* name;
+    int64_t timestamp;
+    int64_t value;
+    TraceEventType type;
+};
+
+// Flight recorder of begin/end and counter events. Every thread writes into its own ring buffer without locking,
+// so recording costs a clock read and a few stores. When disabled, recording is a single relaxed atomic load.
+// The buffer of an exited thread keeps its events and is handed to the next new thread, so the trace thread id
+// identifies a buffer, which may have been used by several threads one after another.
+class TraceRecorder final
+{
+public:
+    static TraceRecorder& getInstance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void begin(const char* name);
+    void end(const char* name);
+    void counter(const char* name, int64_t value);
+
+    // Writes the events of the last duration of all threads in the Chrome Trace Event Format
+    void writeChromeTrace(std::ostream& stream, std::chrono::nanoseconds duration) const;
+
+public:
+    static constexpr size_t ringSize = size_t{1} << 14;
+
+private:
+    // The sequence is odd while the owning thread writes the slot and 2 * index + 2 once event index is complete,
+    // so a dump copies only events that were not overwritten while being read
+    struct EventSlot
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64_t> timestamp{0};
+        std::atomic<int64_t> value{0};
+        std::atomic<TraceEventType> type{TraceEventType::begin};
+    };
+
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(uint32_t threadId);
+
+        const uint32_t threadId;
+        std::atomic<uint64_t> head{0};
+        std::array<EventSlot, ringSize> events{};
+    };
+
+    // Returns the buffer of its thread to the free list when the thread exits
+    struct ThreadBufferOwner;
+
+    void record(const char* name, int64_t value, TraceEventType type);
+    ThreadBuffer& getThreadBuffer();
+    void releaseThreadBuffer(ThreadBuffer* buffer);
+
+private:
+    std::atomic<bool> enabled{false};
+    mutable std::mutex buffersSync;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<ThreadBuffer*> freeBuffers;
+};
+
+class TraceScope final
+{
+public:
+    explicit TraceScope(const char* name)
+        : name(TraceRecorder::getInstance().isEnabled() ? name : nullptr)
+    {
+        if (this->name)
+            TraceRecorder::getInstance().begin(this->name);
+    }
+
+    ~TraceScope()
+    {
+        if (name)
+            TraceRecorder::getInstance().end(name);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+};
+
+// Adds a Tracing switch, TraceDuration in seconds, TraceFile and a DumpTrace procedure writing the file
+void addTraceProperties(PropertyObjectPtr obj);
+
+END_NAMESPACE_ASAM_CMP_COMMON
+
+#define ASAM_CMP_TRACE_CONCAT_IMPL(a, b) a##b
+#define ASAM_CMP_TRACE_CONCAT(a, b) ASAM_CMP_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ASAM_CMP_ENABLE_TRACING
+#define ASAM_CMP_TRACE_SCOPE(name) ::daq::asam_cmp_common_lib::TraceScope ASAM_CMP_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define ASAM_CMP_TRACE_COUNTER(name, value)                                                 \
+    do                                                                                      \
+    {                                                                                       \
+        auto& traceRecorder = ::daq::asam_cmp_common_lib::TraceRecorder::getInstance();    \
+        if (traceRecorder.isEnabled())                                                      \
+            traceRecorder.counter(name, static_cast<int64_t>(value));                       \
+    } while (false)
+#else
+#define ASAM_CMP_TRACE_SCOPE(name)
+#define ASAM_CMP_TRACE_COUNTER(name, value)
+#endif
@@ -13,20 +13,153 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
- 
+
 #pragma once
 
 #include <asam_cmp_common_lib/common.h>
-#include <unordered_map>
-#include <string>
-#include <cstdint>
 #include <array>
+#include <cstdint>
+#include <string_view>
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
 namespace Units {
-    uint8_t getIdBySymbol(const std::string& symbol) noexcept;
-    std::string getSymbolById(uint8_t id) noexcept;
+    // Unit symbols indexed by the ASAM CMP unit id, 0 means no unit
+    inline constexpr std::array<std::string_view, 0x55> unitIdToSymbol = {
+        "",             // 0x00 Unspecified
+        "s",            // 0x01 Time
+        "m",            // 0x02 Length
+        "kg",           // 0x03 Mass
+        "A",            // 0x04 Electric Current
+        "K",            // 0x05 Thermodynamic Temperature
+        "mol",          // 0x06 Amount of Substance
+        "cd",           // 0x07 Luminous Intensity
+        "Hz",           // 0x08 Frequency
+        "rad",          // 0x09 Plane Angle
+        "sr",           // 0x0A Solid Angle
+        "N",            // 0x0B Force
+        "Pa",           // 0x0C Pressure, Stress
+        "J",            // 0x0D Energy, Work, Heat
+        "W",            // 0x0E Power, Radiant Flux
+        "C",            // 0x0F Electric Charge
+        "V",            // 0x10 Electric Potential Difference
+        "F",            // 0x11 Capacitance
+        "Ohm",          // 0x12 Electric Resistance
+        "S",            // 0x13 Electric Conductance
+        "Wb",           // 0x14 Magnetic Flux
+        "T",            // 0x15 Magnetic Flux Density
+        "H",            // 0x16 Inductance
+        "°C",           // 0x17 Celsius Temperature
+        "lm",           // 0x18 Luminous Flux
+        "lx",           // 0x19 Illuminance
+        "Bq",           // 0x1A Activity (of a Radionuclide)
+        "Gy",           // 0x1B Absorbed Dose
+        "Sv",           // 0x1C Dose Equivalent
+        "kat",          // 0x1D Catalytic Activity
+        "m/s",          // 0x1E Speed / Velocity
+        "m/s²",         // 0x1F Acceleration
+        "m/s³",         // 0x20 Jerk
+        "m/s⁴",         // 0x21 Jounce
+        "rad/s",        // 0x22 Angular Velocity
+        "rad/s²",       // 0x23 Angular Acceleration
+        "Hz/s",         // 0x24 Frequency Drift
+        "m³/s",         // 0x25 Volumetric Flow Rate
+        "m²",           // 0x26 Area
+        "m³",           // 0x27 Volume
+        "N s",          // 0x28 Momentum
+        "N m s",        // 0x29 Angular Momentum
+        "N m",          // 0x2A Moment of Force (Torque)
+        "kg/m²",        // 0x2B Area Density
+        "kg/m³",        // 0x2C Mass Density
+        "m³/kg",        // 0x2D Specific Volume
+        "J s",          // 0x2E Action
+        "J/kg",         // 0x2F Specific Energy
+        "J/m³",         // 0x30 Energy Density
+        "N/m",          // 0x31 Surface Tension
+        "W/m²",         // 0x32 Heat Flux Density
+        "m²/s",         // 0x33 Kinematic Viscosity
+        "Pa s",         // 0x34 Dynamic Viscosity
+        "kg/s",         // 0x35 Mass Flow Rate
+        "W/(sr m²)",    // 0x36 Radiance
+        "Gy/s",         // 0x37 Absorbed Dose Rate
+        "m/m³",         // 0x38 Fuel Efficiency
+        "W/m³",         // 0x39 Power Density
+        "J/(m² s)",     // 0x3A Surface Power Density
+        "kg m²",        // 0x3B Moment of Inertia
+        "W/sr",         // 0x3C Radiant Intensity
+        "mol/m³",       // 0x3D Amount of Substance Concentration
+        "m³/mol",       // 0x3E Molar Volume
+        "J/(mol K)",    // 0x3F Molar Heat Capacity
+        "J/mol",        // 0x40 Molar Enthalpy (Energy)
+        "mol/kg",       // 0x41 Molality
+        "kg/mol",       // 0x42 Molar Mass
+        "C/m",          // 0x43 Linear Charge Density
+        "C/m²",         // 0x44 Electric Flux Density
+        "C/m³",         // 0x45 Electric Charge Density
+        "A/m²",         // 0x46 Electric Current Density
+        "S/m",          // 0x47 Electrical Conductivity
+        "F/m",          // 0x48 Permittivity
+        "H/m",          // 0x49 Magnetic Permeability
+        "V/m",          // 0x4A Electric Field Strength
+        "A/m",          // 0x4B Magnetic Field Strength
+        "C/kg",         // 0x4C Radiation Exposure
+        "J/T",          // 0x4D Magnetic Moment
+        "lm s",         // 0x4E Luminous Energy
+        "lx s",         // 0x4F Luminous Exposure
+        "cd/m²",        // 0x50 Luminance
+        "lm/W",         // 0x51 Luminous Efficacy
+        "J/K",          // 0x52 Heat Capacity
+        "J/(K kg)",     // 0x53 Specific Heat Capacity
+        "W/(m K)",      // 0x54 Thermal Conductivity
+    };
+
+    // FNV-1a with a seed under which all symbols land in distinct slots of symbolSlots
+    inline constexpr uint32_t symbolHashSeed = 276731;
+    inline constexpr size_t symbolSlotBits = 8;
+
+    constexpr size_t getSymbolSlot(std::string_view symbol) noexcept
+    {
+        uint32_t hash = 2166136261u ^ symbolHashSeed;
+        for (char c : symbol)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash >> (32 - symbolSlotBits);
+    }
+
+    constexpr std::array<uint8_t, size_t{1} << symbolSlotBits> createSymbolSlots() noexcept
+    {
+        std::array<uint8_t, size_t{1} << symbolSlotBits> slots{};
+        for (size_t id = 1; id < unitIdToSymbol.size(); ++id)
+            slots[getSymbolSlot(unitIdToSymbol[id])] = static_cast<uint8_t>(id);
+        return slots;
+    }
+
+    inline constexpr auto symbolSlots = createSymbolSlots();
+
+    constexpr bool isSymbolHashPerfect() noexcept
+    {
+        for (size_t id = 1; id < unitIdToSymbol.size(); ++id)
+        {
+            if (symbolSlots[getSymbolSlot(unitIdToSymbol[id])] != id)
+                return false;
+        }
+        return true;
+    }
+
+    static_assert(isSymbolHashPerfect(), "Unit symbols collide, choose another symbolHashSeed");
+
+    constexpr uint8_t getIdBySymbol(std::string_view symbol) noexcept
+    {
+        const uint8_t id = symbolSlots[getSymbolSlot(symbol)];
+        return id != 0 && unitIdToSymbol[id] == symbol ? id : 0;
+    }
+
+    constexpr std::string_view getSymbolById(uint8_t id) noexcept
+    {
+        return id < unitIdToSymbol.size() ? unitIdToSymbol[id] : std::string_view{};
+    }
 }
 
 END_NAMESPACE_ASAM_CMP_COMMON
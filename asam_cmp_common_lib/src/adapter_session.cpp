@@ -0,0 +1,364 @@
+#include <asam_cmp_common_lib/adapter_session.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
+#include <algorithm>
+#include <cstring>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    // A filter that doesn't compile must not leave the previous one in place, all CMP frames are captured instead
+    bool setFilters(pcpp::PcapLiveDevice* device, const std::string& captureFilter)
+    {
+        pcpp::EtherTypeFilter ethernetTypeFilter(EthernetPcppImpl::asamCmpEtherType);
+        pcpp::BPFStringFilter messagesFilter(captureFilter);
+
+        pcpp::AndFilter andFilter;
+        andFilter.addFilter(&ethernetTypeFilter);
+        if (!captureFilter.empty())
+            andFilter.addFilter(&messagesFilter);
+        if (device->setFilter(andFilter))
+            return true;
+
+        device->setFilter(ethernetTypeFilter);
+        return false;
+    }
+
+    constexpr size_t maxFrameSize = 1500;
+    constexpr size_t macAddressSize = 6;
+}
+
+AdapterSession::AdapterSession(pcpp::PcapLiveDevice* device, const CaptureConfiguration& configuration)
+    : device(device)
+    , configuration(configuration)
+    , receivers(std::make_shared<Receivers>())
+{
+    device->getMacAddress().copyTo(macAddress.data());
+
+    // Sending in steady state reuses the queued frames without touching the heap
+    for (auto& frame : txQueue)
+        frame.reserve(ethHeaderSize + maxFrameSize);
+}
+
+AdapterSession::~AdapterSession()
+{
+    {
+        std::scoped_lock lock(txSync);
+        txStop = true;
+    }
+    txNotEmpty.notify_all();
+    txNotFull.notify_all();
+    if (txThread.joinable())
+        txThread.join();
+
+    std::scoped_lock lock(deviceSync);
+    stopCapture();
+    if (device->isOpened())
+        device->close();
+}
+
+pcpp::PcapLiveDevice* AdapterSession::getDevice() const
+{
+    return device;
+}
+
+bool AdapterSession::open()
+{
+    std::scoped_lock lock(deviceSync);
+    if (device->isOpened())
+        return true;
+
+    return device->open(getDeviceConfiguration());
+}
+
+bool AdapterSession::setConfiguration(const CaptureConfiguration& configuration)
+{
+    std::scoped_lock lock(deviceSync);
+    if (configuration.bufferSize == this->configuration.bufferSize && configuration.snapshotLength == this->configuration.snapshotLength &&
+        configuration.readTimeout == this->configuration.readTimeout)
+        return true;
+    if (!getReceivers()->empty())
+        return false;
+
+    this->configuration = configuration;
+    // Buffer size, snapshot length and timeout are applied by libpcap on activation only. Without receivers nothing is
+    // captured, so only queued frames wait for the adapter to be reopened.
+    if (device->isOpened())
+    {
+        device->close();
+        device->open(getDeviceConfiguration());
+    }
+    return true;
+}
+
+pcpp::PcapLiveDevice::DeviceConfiguration AdapterSession::getDeviceConfiguration() const
+{
+    // PcapPlusPlus always opens live devices in immediate mode, the flag only affects batch capture
+    return pcpp::PcapLiveDevice::DeviceConfiguration(pcpp::PcapLiveDevice::Promiscuous,
+                                                     configuration.readTimeout,
+                                                     configuration.bufferSize,
+                                                     pcpp::PcapLiveDevice::PCPP_INOUT,
+                                                     configuration.snapshotLength);
+}
+
+void AdapterSession::send(const std::vector<uint8_t>& data)
+{
+    std::unique_lock lock(txSync);
+    txNotFull.wait(lock, [this] { return txCount < txQueueSize || txStop; });
+    if (txStop)
+        return;
+
+    if (!txThread.joinable())
+        txThread = std::thread(&AdapterSession::txLoop, this);
+
+    auto& frame = txQueue[(txHead + txCount) % txQueueSize];
+    frame.resize(ethHeaderSize + data.size());
+    std::fill_n(frame.begin(), macAddressSize, uint8_t{0xFF});
+    std::copy(macAddress.begin(), macAddress.end(), frame.begin() + macAddressSize);
+    frame[2 * macAddressSize] = static_cast<uint8_t>(EthernetPcppImpl::asamCmpEtherType >> 8);
+    frame[2 * macAddressSize + 1] = static_cast<uint8_t>(EthernetPcppImpl::asamCmpEtherType & 0xFF);
+    std::copy(data.begin(), data.end(), frame.begin() + ethHeaderSize);
+    ++txCount;
+
+    lock.unlock();
+    txNotEmpty.notify_one();
+}
+
+void AdapterSession::txLoop()
+{
+    std::unique_lock lock(txSync);
+    while (true)
+    {
+        txNotEmpty.wait(lock, [this] { return txCount > 0 || txStop; });
+        if (txCount == 0)
+            return;
+
+        // Senders only write behind the queued frames, so the head frame can be sent without the lock
+        const auto& frame = txQueue[txHead];
+        lock.unlock();
+        {
+            ASAM_CMP_LATENCY_SCOPE(send);
+            ASAM_CMP_TRACE_SCOPE("EthernetSend");
+            std::scoped_lock deviceLock(deviceSync);
+            device->sendPacket(frame.data(), static_cast<int>(frame.size()));
+        }
+        lock.lock();
+
+        txHead = (txHead + 1) % txQueueSize;
+        --txCount;
+        txNotFull.notify_one();
+    }
+}
+
+size_t AdapterSession::addReceiver(PcppPacketReceivedCallbackType callback, const std::string& filter, bool suppressLocalFrames)
+{
+    std::scoped_lock lock(deviceSync);
+    auto newReceivers = std::make_shared<Receivers>(*getReceivers());
+    const auto receiverId = nextReceiverId++;
+    newReceivers->emplace(receiverId,
+                          Receiver{std::move(callback), filter, createBpfFilter(filter), suppressLocalFrames, std::make_shared<ReceiverState>()});
+    setReceivers(std::move(newReceivers));
+
+    if (device->captureActive())
+        setFilters(device, getCombinedFilter());
+    else
+        startCapture();
+
+    return receiverId;
+}
+
+bool AdapterSession::setReceiverFilter(size_t receiverId, const std::string& filter)
+{
+    std::scoped_lock lock(deviceSync);
+    auto newReceivers = std::make_shared<Receivers>(*getReceivers());
+    auto it = newReceivers->find(receiverId);
+    if (it == newReceivers->end() || it->second.filter == filter)
+        return true;
+
+    it->second.filter = filter;
+    it->second.bpfFilter = createBpfFilter(filter);
+    setReceivers(std::move(newReceivers));
+
+    return !device->captureActive() || setFilters(device, getCombinedFilter());
+}
+
+void AdapterSession::removeReceiver(size_t receiverId)
+{
+    std::unique_lock lock(deviceSync);
+    auto newReceivers = std::make_shared<Receivers>(*getReceivers());
+    auto it = newReceivers->find(receiverId);
+    if (it == newReceivers->end())
+        return;
+    const auto state = it->second.state;
+    newReceivers->erase(it);
+    setReceivers(std::move(newReceivers));
+
+    // A dispatch holding an older snapshot either sees the flag or is counted as active. Only the callback of this
+    // receiver is waited for, and the device lock is released meanwhile, so the transmit thread can drain frames the
+    // callback might be waiting to queue.
+    state->removed = true;
+    if (std::this_thread::get_id() != captureThreadId.load())
+    {
+        lock.unlock();
+        while (state->activeCallbacks > 0)
+            std::this_thread::yield();
+        lock.lock();
+    }
+
+    if (getReceivers()->empty())
+        stopCapture();
+    else if (device->captureActive())
+        setFilters(device, getCombinedFilter());
+}
+
+std::shared_ptr<const AdapterSession::Receivers> AdapterSession::getReceivers() const
+{
+    std::scoped_lock lock(receiversSync);
+    return receivers;
+}
+
+void AdapterSession::setReceivers(std::shared_ptr<const Receivers> newReceivers)
+{
+    std::scoped_lock lock(receiversSync);
+    receivers = std::move(newReceivers);
+}
+
+void AdapterSession::startCapture()
+{
+    if (!device->isOpened())
+        return;
+
+    setFilters(device, getCombinedFilter());
+    device->startCapture([this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie) { onPacketArrives(packet, dev, cookie); },
+                         nullptr);
+}
+
+void AdapterSession::stopCapture()
+{
+    if (device->captureActive())
+        device->stopCapture();
+}
+
+std::string AdapterSession::getCombinedFilter() const
+{
+    std::vector<std::string> filters;
+    for (const auto& [receiverId, receiver] : *getReceivers())
+    {
+        // A receiver without a filter needs every CMP frame
+        if (receiver.filter.empty())
+            return {};
+        if (std::find(filters.begin(), filters.end(), receiver.filter) == filters.end())
+            filters.push_back(receiver.filter);
+    }
+
+    if (filters.size() == 1)
+        return filters.front();
+
+    std::string combinedFilter;
+    for (const auto& filter : filters)
+        combinedFilter += (combinedFilter.empty() ? "(" : " or (") + filter + ")";
+    return combinedFilter;
+}
+
+void AdapterSession::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
+{
+    ASAM_CMP_TRACE_SCOPE("EthernetReceive");
+
+    updateStatistics();
+
+    captureThreadId = std::this_thread::get_id();
+    const bool localFrame = isLocalFrame(packet);
+    const auto currentReceivers = getReceivers();
+    for (const auto& [receiverId, receiver] : *currentReceivers)
+    {
+        if (localFrame && receiver.suppressLocalFrames)
+            continue;
+        // The adapter captures the frames of all receivers, so every receiver gets only the ones its filter passes
+        if (receiver.bpfFilter && !receiver.bpfFilter->matchPacketWithFilter(packet))
+            continue;
+
+        auto& state = *receiver.state;
+        ++state.activeCallbacks;
+        if (!state.removed)
+            receiver.callback(packet, dev, cookie);
+        --state.activeCallbacks;
+    }
+}
+
+std::shared_ptr<pcpp::BpfFilterWrapper> AdapterSession::createBpfFilter(const std::string& filter)
+{
+    if (filter.empty())
+        return nullptr;
+
+    auto bpfFilter = std::make_shared<pcpp::BpfFilterWrapper>();
+    if (!bpfFilter->setFilter(filter))
+        return nullptr;
+    return bpfFilter;
+}
+
+CaptureStatistics AdapterSession::getStatistics() const
+{
+    std::scoped_lock lock(statisticsSync);
+    return statistics;
+}
+
+void AdapterSession::updateStatistics()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextStatisticsUpdate)
+        return;
+    nextStatisticsUpdate = now + statisticsPeriod;
+
+    pcpp::IPcapDevice::PcapStats stats{};
+    device->getStatistics(stats);
+
+    std::scoped_lock lock(statisticsSync);
+    statistics.received = stats.packetsRecv;
+    statistics.droppedByKernel = stats.packetsDrop;
+    statistics.droppedByInterface = stats.packetsDropByInterface;
+}
+
+bool AdapterSession::isLocalFrame(const pcpp::RawPacket* packet) const
+{
+    return packet->getRawDataLen() >= static_cast<int>(ethHeaderSize) &&
+           std::memcmp(packet->getRawData() + macAddressSize, macAddress.data(), macAddressSize) == 0;
+}
+
+AdapterSessionRegistry& AdapterSessionRegistry::getInstance()
+{
+    static AdapterSessionRegistry instance;
+    return instance;
+}
+
+std::shared_ptr<AdapterSession> AdapterSessionRegistry::acquire(pcpp::PcapLiveDevice* device, const CaptureConfiguration& configuration)
+{
+    std::unique_lock lock(sync);
+    for (auto it = sessions.find(device); it != sessions.end(); it = sessions.find(device))
+    {
+        if (auto session = it->second.lock())
+            return session;
+
+        // The last user has just released the previous session, wait until it has closed the adapter
+        sessionReleased.wait(lock);
+    }
+
+    std::shared_ptr<AdapterSession> session(new AdapterSession(device, configuration), [this](AdapterSession* session) { release(session); });
+    sessions.emplace(device, session);
+    return session;
+}
+
+void AdapterSessionRegistry::release(AdapterSession* session)
+{
+    const auto device = session->getDevice();
+    delete session;
+
+    {
+        std::scoped_lock lock(sync);
+        sessions.erase(device);
+    }
+    sessionReleased.notify_all();
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,184 @@
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+#include <RawPacket.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    constexpr size_t ethHeaderSize = 14;
+    constexpr std::array<uint8_t, ethHeaderSize> ethHeader{
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x99, 0xFE};
+
+    timespec getCurrentTime()
+    {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now);
+
+        timespec result{};
+        result.tv_sec = static_cast<decltype(result.tv_sec)>(seconds.count());
+        result.tv_nsec = static_cast<decltype(result.tv_nsec)>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - seconds).count());
+        return result;
+    }
+}
+
+EthernetLoopbackImpl::EthernetLoopbackImpl(size_t queueCapacity)
+    : queueCapacity(queueCapacity)
+{
+}
+
+EthernetLoopbackImpl::~EthernetLoopbackImpl()
+{
+    stopCapture();
+}
+
+ListPtr<StringPtr> EthernetLoopbackImpl::getEthernetDevicesNamesList()
+{
+    ListPtr<StringPtr> names{deviceName};
+    return names;
+}
+
+ListPtr<StringPtr> EthernetLoopbackImpl::getEthernetDevicesDescriptionsList()
+{
+    ListPtr<StringPtr> descriptions{"In-process loopback"};
+    return descriptions;
+}
+
+void EthernetLoopbackImpl::sendPacket(const std::vector<uint8_t>& data)
+{
+    Frame frame;
+    frame.data.reserve(ethHeaderSize + data.size());
+    frame.data.insert(frame.data.end(), ethHeader.begin(), ethHeader.end());
+    frame.data.insert(frame.data.end(), data.begin(), data.end());
+    frame.timestamp = getCurrentTime();
+
+    {
+        std::scoped_lock lock(queueSync);
+        if (!capturing)
+            return;
+
+        if (queue.size() >= queueCapacity)
+        {
+            ++dropped;
+            return;
+        }
+        queue.push_back(std::move(frame));
+    }
+    queueCv.notify_one();
+}
+
+void EthernetLoopbackImpl::startCapture(PcppPacketReceivedCallbackType packetReceivedCb)
+{
+    startDelivery(std::move(packetReceivedCb), nullptr);
+}
+
+void EthernetLoopbackImpl::startBatchCapture(PcppPacketsReceivedCallbackType packetsReceivedCb)
+{
+    startDelivery(nullptr, std::move(packetsReceivedCb));
+}
+
+void EthernetLoopbackImpl::startDelivery(PcppPacketReceivedCallbackType packetReceivedCb, PcppPacketsReceivedCallbackType packetsReceivedCb)
+{
+    stopCapture();
+
+    {
+        std::scoped_lock lock(queueSync);
+        capturing = true;
+    }
+    deliveryThread = std::thread(&EthernetLoopbackImpl::deliveryLoop, this, std::move(packetReceivedCb), std::move(packetsReceivedCb));
+}
+
+void EthernetLoopbackImpl::stopCapture()
+{
+    {
+        std::scoped_lock lock(queueSync);
+        capturing = false;
+        queue.clear();
+    }
+    queueCv.notify_all();
+
+    if (deliveryThread.joinable())
+        deliveryThread.join();
+}
+
+bool EthernetLoopbackImpl::isDeviceCapturing() const
+{
+    std::scoped_lock lock(queueSync);
+    return capturing;
+}
+
+bool EthernetLoopbackImpl::setDevice(const StringPtr& name)
+{
+    return name.toStdString() == deviceName;
+}
+
+StringPtr EthernetLoopbackImpl::getActiveDeviceName() const
+{
+    return String(deviceName);
+}
+
+bool EthernetLoopbackImpl::setCaptureFilter(const std::string& filter)
+{
+    return true;
+}
+
+CaptureStatistics EthernetLoopbackImpl::getCaptureStatistics() const
+{
+    std::scoped_lock lock(queueSync);
+
+    CaptureStatistics statistics;
+    statistics.received = received;
+    statistics.droppedByKernel = dropped;
+    return statistics;
+}
+
+bool EthernetLoopbackImpl::setCaptureConfiguration(const CaptureConfiguration& configuration)
+{
+    std::scoped_lock lock(queueSync);
+    batchSize = std::max(configuration.batchSize, 1);
+    return true;
+}
+
+void EthernetLoopbackImpl::deliveryLoop(PcppPacketReceivedCallbackType packetReceivedCb, PcppPacketsReceivedCallbackType packetsReceivedCb)
+{
+    std::vector<Frame> frames;
+    std::vector<pcpp::RawPacket> rawPackets;
+    std::vector<pcpp::RawPacket*> rawPacketPtrs;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(queueSync);
+            queueCv.wait(lock, [this] { return !capturing || !queue.empty(); });
+            if (!capturing)
+                return;
+
+            const size_t count = std::min(queue.size(), packetsReceivedCb ? batchSize : queue.size());
+            frames.assign(std::make_move_iterator(queue.begin()), std::make_move_iterator(queue.begin() + count));
+            queue.erase(queue.begin(), queue.begin() + count);
+            received += count;
+        }
+
+        rawPackets.clear();
+        rawPackets.reserve(frames.size());
+        for (auto& frame : frames)
+            rawPackets.emplace_back(frame.data.data(), static_cast<int>(frame.data.size()), frame.timestamp, false, pcpp::LINKTYPE_ETHERNET);
+
+        if (packetsReceivedCb)
+        {
+            rawPacketPtrs.clear();
+            for (auto& rawPacket : rawPackets)
+                rawPacketPtrs.push_back(&rawPacket);
+            packetsReceivedCb(rawPacketPtrs);
+        }
+        else
+        {
+            for (auto& rawPacket : rawPackets)
+                packetReceivedCb(&rawPacket, nullptr, nullptr);
+        }
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -1,67 +1,72 @@
 #include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
 #include <PcapLiveDeviceList.h>
 #include <SystemUtils.h>
-#include <EthLayer.h>
-#include <PayloadLayer.h>
+#include <algorithm>
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
 EthernetPcppImpl::EthernetPcppImpl()
     : deviceList(createAvailableDevicesList())
-    , activeDevice(getFirstAvailableDevice())
+    , activeDevice(deviceList.empty() ? nullptr : deviceList.front())
 {
 
 }
 
+EthernetPcppImpl::~EthernetPcppImpl()
+{
+    // The shared live capture must not call back into the owner of this wrapper anymore
+    stopCapture();
+}
+
 std::vector<pcpp::PcapLiveDevice*> EthernetPcppImpl::createAvailableDevicesList() const
 {
     return pcapDeviceList.getPcapLiveDevicesList();
 }
 
-pcpp::PcapLiveDevice* EthernetPcppImpl::getFirstAvailableDevice() const
+std::shared_ptr<AdapterSession> EthernetPcppImpl::getOpenedSession(pcpp::PcapLiveDevice* device)
 {
-    for (const auto& device : deviceList)
+    // Streams may send from several threads before the first frame opened the device
+    std::scoped_lock lock(sessionsSync);
+    auto& session = sessions[device];
+    if (!session)
+        session = AdapterSessionRegistry::getInstance().acquire(device, captureConfiguration);
+    if (session->open())
+        return session;
+
+    sessions.erase(device);
+    return nullptr;
+}
+
+std::shared_ptr<AdapterSession> EthernetPcppImpl::getActiveSession()
+{
+    if (activeDevice == nullptr)
+        return nullptr;
+    if (deviceResolved)
+        return getOpenedSession(activeDevice);
+
+    // Adapters are tried in list order once, later failures are reported for the resolved adapter only
+    deviceResolved = true;
+    for (auto it = std::find(deviceList.begin(), deviceList.end(), activeDevice); it != deviceList.end(); ++it)
     {
-        try
-        {
-            return getPcapLiveDevice(device->getName());
-        }
-        catch (...)
+        if (auto session = getOpenedSession(*it))
         {
-            continue;
+            activeDevice = *it;
+            return session;
         }
     }
-
     return nullptr;
 }
 
-void setFilters(pcpp::PcapLiveDevice* device)
+std::string EthernetPcppImpl::getBpfFilter() const
 {
-    // create a filters
-    pcpp::EtherTypeFilter ethernetTypeFilter(EthernetPcppImpl::asamCmpEtherType);
-
-    // create an AND filter to combine both filters
-    pcpp::AndFilter andFilter;
-    andFilter.addFilter(&ethernetTypeFilter);
-    // set the filter on the device
-    device->setFilter(andFilter);
-}
-
-pcpp::PcapLiveDevice* EthernetPcppImpl::getPcapLiveDevice(const StringPtr& deviceName) const
-{
-    auto pcapLiveDevice = pcapDeviceList.getPcapLiveDeviceByName(deviceName);
-    if (!pcapLiveDevice)
-    {
-        std::string err = fmt::format("Can't find device {}", deviceName);
-        throw std::invalid_argument(err);
-    }
-    if (!pcapLiveDevice->open())
-    {
-        std::string err = fmt::format("Can't open device {}", deviceName);
-        throw std::invalid_argument(err);
-    }
-
-    return pcapLiveDevice;
+    auto filter = fmt::format("ether proto {:#06x}", asamCmpEtherType);
+    if (!captureFilter.empty())
+        filter += fmt::format(" and ({})", captureFilter);
+    // Batch capture has its own handle, so the frames sent from this host are filtered out by the kernel
+    if (captureConfiguration.suppressLocalFrames && activeDevice != nullptr)
+        filter += fmt::format(" and not ether src {}", activeDevice->getMacAddress().toString());
+
+    return filter;
 }
 
 ListPtr<StringPtr> EthernetPcppImpl::getEthernetDevicesNamesList()
@@ -92,55 +97,140 @@ ListPtr<StringPtr> EthernetPcppImpl::getEthernetDevicesDescriptionsList()
 
 bool EthernetPcppImpl::setDevice(const StringPtr& deviceName)
 {
-    pcpp::PcapLiveDevice* oldDevice = activeDevice;
-    try
-    {
-        activeDevice = getPcapLiveDevice(deviceName);
-    }
-    catch (...)
-    {
-        activeDevice = oldDevice;
+    auto device = pcapDeviceList.getPcapLiveDeviceByName(deviceName);
+    if (device == nullptr)
+        return false;
+
+    std::scoped_lock lock(captureSync);
+    auto session = getOpenedSession(device);
+    if (!session)
         return false;
+
+    if (device != activeDevice)
+    {
+        stopCaptureInternal();
+        activeDevice = device;
     }
+    deviceResolved = true;
+
+    std::scoped_lock sessionsLock(sessionsSync);
+    activeSession = std::move(session);
 
     return true;
 }
 
+StringPtr EthernetPcppImpl::getActiveDeviceName() const
+{
+    std::scoped_lock lock(captureSync);
+    return activeDevice == nullptr ? StringPtr() : String(activeDevice->getName());
+}
+
+bool EthernetPcppImpl::setCaptureFilter(const std::string& filter)
+{
+    // Long OR chains may not compile, capturing all CMP frames is better than keeping the stale filter
+    pcpp::BPFStringFilter bpfFilter(filter);
+    const bool valid = filter.empty() || bpfFilter.verifyFilter();
+
+    std::scoped_lock lock(captureSync);
+    captureFilter = valid ? filter : std::string();
+
+    if (batchCapture)
+        batchCapture->setFilter(getBpfFilter());
+    else if (receiverId)
+        return receivingSession->setReceiverFilter(*receiverId, captureFilter) && valid;
+
+    return valid;
+}
+
+bool EthernetPcppImpl::setCaptureConfiguration(const CaptureConfiguration& configuration)
+{
+    std::scoped_lock lock(captureSync);
+    // The own receiver is removed first, so the settings only apply when no other module captures from the adapter
+    stopCaptureInternal();
+    captureConfiguration = configuration;
+
+    bool applied = true;
+    std::scoped_lock sessionsLock(sessionsSync);
+    for (const auto& [device, session] : sessions)
+        applied = session->setConfiguration(configuration) && applied;
+
+    return applied;
+}
+
+CaptureStatistics EthernetPcppImpl::getCaptureStatistics() const
+{
+    std::scoped_lock lock(captureSync);
+    // The capture threads sample the statistics, the caller's thread never touches a capturing handle
+    if (batchCapture)
+        return batchCapture->getStatistics();
+    if (receivingSession)
+        return receivingSession->getStatistics();
+
+    return {};
+}
+
 void EthernetPcppImpl::sendPacket(const std::vector<uint8_t>& data)
 {
-    // create a new Ethernet layer
-    pcpp::EthLayer newEthernetLayer(
-        pcpp::MacAddress(activeDevice->getMacAddress()), pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), asamCmpEtherType);
-    pcpp::PayloadLayer payloadLayer(data.data(), data.size());
-    // create a packet with initial capacity of 100 bytes (will grow automatically if needed)
-    pcpp::Packet newPacket(100);
-    bool res = newPacket.addLayer(&newEthernetLayer);
-    assert(res);
-    res = newPacket.addLayer(&payloadLayer);
-    assert(res);
-    // compute all calculated fields
-    newPacket.computeCalculateFields();
+    std::shared_ptr<AdapterSession> session;
+    {
+        std::scoped_lock lock(sessionsSync);
+        session = activeSession;
+    }
+    if (!session)
+    {
+        std::scoped_lock lock(captureSync);
+        session = getActiveSession();
+    }
 
-    activeDevice->sendPacket(&newPacket);
+    if (session)
+        session->send(data);
 }
 
 void EthernetPcppImpl::startCapture(std::function<void(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)> onPacketReceivedCb)
 {
-    stopCapture();
-    setFilters(activeDevice);
+    std::scoped_lock lock(captureSync);
+    stopCaptureInternal();
+    auto session = getActiveSession();
+    if (!session)
+        throw std::runtime_error("Network adapter can't be opened");
+
+    receiverId = session->addReceiver(std::move(onPacketReceivedCb), captureFilter, captureConfiguration.suppressLocalFrames);
+    receivingSession = std::move(session);
+}
 
-    activeDevice->startCapture(onPacketReceivedCb, nullptr);
+void EthernetPcppImpl::startBatchCapture(PcppPacketsReceivedCallbackType packetsReceivedCb)
+{
+    std::scoped_lock lock(captureSync);
+    stopCaptureInternal();
+    if (!deviceResolved)
+        getActiveSession();
+    if (activeDevice == nullptr)
+        throw std::runtime_error("No network adapter is available");
+
+    batchCapture = std::make_unique<PcapBatchCapture>(activeDevice->getName(), captureConfiguration, getBpfFilter(), packetsReceivedCb);
 }
 
 void EthernetPcppImpl::stopCapture()
 {
-    if (isDeviceCapturing())
-        activeDevice->stopCapture();
+    std::scoped_lock lock(captureSync);
+    stopCaptureInternal();
+}
+
+void EthernetPcppImpl::stopCaptureInternal()
+{
+    batchCapture.reset();
+    if (receiverId)
+    {
+        receivingSession->removeReceiver(*receiverId);
+        receiverId.reset();
+        receivingSession.reset();
+    }
 }
 
 bool EthernetPcppImpl::isDeviceCapturing() const
 {
-    return activeDevice->captureActive();
+    std::scoped_lock lock(captureSync);
+    return batchCapture != nullptr || receiverId.has_value();
 }
 
 END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,173 @@
+#include <coreobjects/callable_info_factory.h>
+#include <coreobjects/property_factory.h>
+#include <coreobjects/property_object_protected_ptr.h>
+#include <coretypes/procedure_factory.h>
+#include <algorithm>
+#include <cmath>
+
+#include <asam_cmp_common_lib/latency_histogram.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    size_t getMostSignificantBit(uint64_t value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    constexpr size_t subBucketsCount = size_t{1} << LatencyHistogram::subBucketBits;
+    constexpr size_t firstLogarithmicBit = 5;
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value)
+{
+    if (value < linearBucketsCount)
+        return static_cast<size_t>(value);
+
+    const auto bit = getMostSignificantBit(value);
+    const auto shift = bit - subBucketBits;
+    const auto subBucket = static_cast<size_t>(value >> shift) & (subBucketsCount - 1);
+    return linearBucketsCount + (bit - firstLogarithmicBit) * subBucketsCount + subBucket;
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(size_t index)
+{
+    if (index < linearBucketsCount)
+        return index;
+
+    const auto bit = (index - linearBucketsCount) / subBucketsCount + firstLogarithmicBit;
+    const auto subBucket = (index - linearBucketsCount) % subBucketsCount;
+    const auto shift = bit - subBucketBits;
+    const uint64_t lowerBound = static_cast<uint64_t>(subBucketsCount + subBucket) << shift;
+    return lowerBound + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    auto currentMax = max.load(std::memory_order_relaxed);
+    while (value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed))
+        ;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax() const
+{
+    return max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const
+{
+    const auto total = getCount();
+    if (total == 0)
+        return 0;
+
+    const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total))));
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < bucketsCount; ++i)
+    {
+        accumulated += buckets[i].load(std::memory_order_relaxed);
+        if (accumulated >= target)
+            return std::min(getBucketUpperBound(i), getMax());
+    }
+
+    return getMax();
+}
+
+LatencyStatistics& LatencyStatistics::getInstance()
+{
+    static LatencyStatistics instance;
+    return instance;
+}
+
+LatencyHistogram& LatencyStatistics::getHistogram(LatencyStage stage)
+{
+    return histograms[static_cast<size_t>(stage)];
+}
+
+const char* LatencyStatistics::getStageName(LatencyStage stage)
+{
+    switch (stage)
+    {
+        case LatencyStage::dequeue:
+            return "Dequeue";
+        case LatencyStage::encode:
+            return "Encode";
+        case LatencyStage::send:
+            return "Send";
+        case LatencyStage::kernelRx:
+            return "KernelRx";
+        case LatencyStage::decode:
+            return "Decode";
+        case LatencyStage::publish:
+            return "Publish";
+        case LatencyStage::packetCreation:
+            return "PacketCreation";
+        default:
+            return "Unknown";
+    }
+}
+
+void addLatencyProperties(PropertyObjectPtr obj, std::initializer_list<LatencyStage> stages)
+{
+    auto& statistics = LatencyStatistics::getInstance();
+    for (const auto stage : stages)
+    {
+        auto& histogram = statistics.getHistogram(stage);
+        const std::string stageName = LatencyStatistics::getStageName(stage);
+
+        const auto addPercentile = [&obj, &histogram, &stageName](const std::string& suffix, double percentile)
+        {
+            const StringPtr propName = stageName + "Latency" + suffix;
+            obj.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+            obj.getOnPropertyValueRead(propName) += [&histogram, percentile](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+            {
+                const auto value = percentile < 100.0 ? histogram.getPercentile(percentile) : histogram.getMax();
+                args.setValue(Integer(static_cast<Int>(value)));
+            };
+        };
+
+        addPercentile("P50", 50.0);
+        addPercentile("P99", 99.0);
+        addPercentile("P999", 99.9);
+        addPercentile("Max", 100.0);
+    }
+
+    const StringPtr propName = "ResetLatency";
+    obj.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    const std::vector<LatencyStage> resetStages(stages);
+    auto proc = Procedure(
+        [&statistics, resetStages]()
+        {
+            for (const auto stage : resetStages)
+                statistics.getHistogram(stage).reset();
+        });
+    obj.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, proc);
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
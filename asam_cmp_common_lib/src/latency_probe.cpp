@@ -0,0 +1,63 @@
+#include <asam_cmp_common_lib/latency_probe.h>
+#include <algorithm>
+#include <array>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    // CMP message header, vendor id, magic, TX time
+    constexpr uint8_t cmpVersion = 0x01;
+    constexpr size_t deviceIdOffset = 2;
+    constexpr size_t messageTypeOffset = 4;
+    constexpr size_t sequenceCounterOffset = 6;
+    constexpr size_t vendorIdOffset = 8;
+    constexpr size_t magicOffset = 10;
+    constexpr size_t txTimeOffset = 14;
+    constexpr std::array<uint8_t, 4> magic{'L', 'P', 'R', 'B'};
+
+    template <typename T>
+    void writeBigEndian(uint8_t* data, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+            data[i] = static_cast<uint8_t>(value >> (8 * (sizeof(T) - 1 - i)));
+    }
+
+    template <typename T>
+    T readBigEndian(const uint8_t* data)
+    {
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            value = static_cast<T>((value << 8) | data[i]);
+        return value;
+    }
+}
+
+std::vector<uint8_t> encodeLatencyProbe(const LatencyProbe& probe)
+{
+    std::vector<uint8_t> data(latencyProbeSize, 0);
+    data[0] = cmpVersion;
+    writeBigEndian(data.data() + deviceIdOffset, probe.deviceId);
+    data[messageTypeOffset] = latencyProbeMessageType;
+    writeBigEndian(data.data() + sequenceCounterOffset, probe.sequenceCounter);
+    writeBigEndian(data.data() + vendorIdOffset, latencyProbeVendorId);
+    std::copy(magic.begin(), magic.end(), data.begin() + magicOffset);
+    writeBigEndian(data.data() + txTimeOffset, probe.txTime);
+    return data;
+}
+
+bool decodeLatencyProbe(const uint8_t* data, size_t size, LatencyProbe& probe)
+{
+    if (size < latencyProbeSize || data[messageTypeOffset] != latencyProbeMessageType)
+        return false;
+    if (readBigEndian<uint16_t>(data + vendorIdOffset) != latencyProbeVendorId ||
+        !std::equal(magic.begin(), magic.end(), data + magicOffset))
+        return false;
+
+    probe.deviceId = readBigEndian<uint16_t>(data + deviceIdOffset);
+    probe.sequenceCounter = readBigEndian<uint16_t>(data + sequenceCounterOffset);
+    probe.txTime = readBigEndian<uint64_t>(data + txTimeOffset);
+    return true;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
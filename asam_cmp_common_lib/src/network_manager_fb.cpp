@@ -29,17 +29,7 @@ void NetworkManagerFb::addNetworkAdaptersProperty()
     ListPtr<StringPtr> devicesNames = ethernetWrapper->getEthernetDevicesNamesList();
     ListPtr<StringPtr> devicesDescriptions = ethernetWrapper->getEthernetDevicesDescriptionsList();
 
-    int selectedDeviceInd = 0;
-    for (int i = 0; i < devicesNames.getCount(); ++i)
-    {
-        if (ethernetWrapper->setDevice(devicesNames[i]))
-        {
-            selectedDeviceInd = i;
-            selectedEthernetDeviceName = devicesNames[i];
-            break;
-        }
-    }
-
+    // The first adapter stays selected without being opened, the wrapper opens it on first use
     StringPtr propName = "NetworkAdaptersNames";
     auto prop = SelectionPropertyBuilder(propName, devicesNames, 0).setVisible(false).build();
     objPtr.addProperty(prop);
@@ -47,6 +37,12 @@ void NetworkManagerFb::addNetworkAdaptersProperty()
     propName = "NetworkAdapters";
     prop = SelectionPropertyBuilder(propName, devicesDescriptions, 0).build();
     objPtr.addProperty(prop);
+    // The wrapper falls through to the next adapter if the default one can't be opened, reads report the one actually used
+    objPtr.getOnPropertyValueRead(propName) += [this, devicesNames](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        if (const auto index = getActiveAdapterIndex(devicesNames); index >= 0)
+            args.setValue(Integer(index));
+    };
     objPtr.getOnPropertyValueWrite(propName) += [this, propName](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
     {
  //       setPropertyValueInternal(
@@ -71,5 +67,25 @@ void NetworkManagerFb::addNetworkAdaptersProperty()
     };
 }
 
+Int NetworkManagerFb::getActiveAdapterIndex(const ListPtr<StringPtr>& devicesNames) const
+{
+    const StringPtr activeName = ethernetWrapper->getActiveDeviceName();
+    if (!activeName.assigned())
+        return -1;
+
+    for (SizeT index = 0; index < devicesNames.getCount(); ++index)
+    {
+        if (devicesNames[index].toStdString() == activeName.toStdString())
+            return static_cast<Int>(index);
+    }
+    return -1;
+}
+
+void NetworkManagerFb::updateSelectedAdapterName()
+{
+    const StringPtr activeName = ethernetWrapper->getActiveDeviceName();
+    if (activeName.assigned())
+        selectedEthernetDeviceName = activeName;
+}
 
 END_NAMESPACE_ASAM_CMP_COMMON
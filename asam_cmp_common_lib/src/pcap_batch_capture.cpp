@@ -0,0 +1,157 @@
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/pcap_batch_capture.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
+#include <algorithm>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+PcapBatchCapture::PcapBatchCapture(const std::string& deviceName,
+                                   const CaptureConfiguration& configuration,
+                                   const std::string& filter,
+                                   PcppPacketsReceivedCallbackType packetsReceivedCb)
+    : batchSize(std::max(configuration.batchSize, 1))
+    , packetsReceivedCb(std::move(packetsReceivedCb))
+{
+    char errorBuffer[PCAP_ERRBUF_SIZE];
+    handle = pcap_create(deviceName.c_str(), errorBuffer);
+    if (handle == nullptr)
+        throw std::runtime_error(fmt::format("Can't open device {}: {}", deviceName, errorBuffer));
+
+    if (configuration.snapshotLength > 0)
+        pcap_set_snaplen(handle, configuration.snapshotLength);
+    if (configuration.bufferSize > 0)
+        pcap_set_buffer_size(handle, configuration.bufferSize);
+    // A finite timeout lets the capture thread notice a stop request when the line is idle
+    pcap_set_timeout(handle, configuration.readTimeout > 0 ? configuration.readTimeout : defaultReadTimeout);
+    pcap_set_immediate_mode(handle, configuration.immediateMode ? 1 : 0);
+    pcap_set_promisc(handle, 1);
+
+    if (pcap_activate(handle) < 0)
+    {
+        std::string err = fmt::format("Can't activate device {}: {}", deviceName, pcap_geterr(handle));
+        pcap_close(handle);
+        throw std::runtime_error(err);
+    }
+
+    applyFilter(filter);
+
+    rawPackets.reserve(batchSize);
+    batch.reserve(batchSize);
+    headers.reserve(batchSize);
+
+    captureThread = std::thread([this] { run(); });
+}
+
+PcapBatchCapture::~PcapBatchCapture()
+{
+    running = false;
+    pcap_breakloop(handle);
+    if (captureThread.joinable())
+        captureThread.join();
+
+    pcap_close(handle);
+}
+
+void PcapBatchCapture::setFilter(const std::string& filter)
+{
+    std::scoped_lock lock{filterSync};
+    pendingFilter = filter;
+    filterChanged = true;
+}
+
+CaptureStatistics PcapBatchCapture::getStatistics() const
+{
+    std::scoped_lock lock{statisticsSync};
+    return statistics;
+}
+
+void PcapBatchCapture::updateStatistics()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextStatisticsUpdate)
+        return;
+    nextStatisticsUpdate = now + statisticsPeriod;
+
+    pcap_stat stats{};
+    if (pcap_stats(handle, &stats) != 0)
+        return;
+
+    std::scoped_lock lock{statisticsSync};
+    statistics.received = stats.ps_recv;
+    statistics.droppedByKernel = stats.ps_drop;
+    statistics.droppedByInterface = stats.ps_ifdrop;
+}
+
+void PcapBatchCapture::run()
+{
+    while (running)
+    {
+        {
+            std::scoped_lock lock{filterSync};
+            if (filterChanged)
+            {
+                applyFilter(pendingFilter);
+                filterChanged = false;
+            }
+        }
+
+        const int count = pcap_dispatch(handle, batchSize, &PcapBatchCapture::onPacket, reinterpret_cast<u_char*>(this));
+        if (count > 0)
+            deliverBatch();
+        else if (count == PCAP_ERROR)
+            break;
+
+        // The read timeout returns from pcap_dispatch on an idle line too, so the statistics stay current
+        updateStatistics();
+    }
+}
+
+void PcapBatchCapture::applyFilter(const std::string& filter)
+{
+    if (compileFilter(filter))
+        return;
+
+    // A stale filter would silently drop the frames of new subscriptions, so all CMP frames are captured instead
+    compileFilter(fmt::format("ether proto {:#06x}", EthernetPcppImpl::asamCmpEtherType));
+}
+
+bool PcapBatchCapture::compileFilter(const std::string& filter)
+{
+    bpf_program program{};
+    if (pcap_compile(handle, &program, filter.c_str(), 1, PCAP_NETMASK_UNKNOWN) != 0)
+        return false;
+
+    const bool applied = pcap_setfilter(handle, &program) == 0;
+    pcap_freecode(&program);
+    return applied;
+}
+
+void PcapBatchCapture::deliverBatch()
+{
+    ASAM_CMP_TRACE_SCOPE("EthernetReceiveBatch");
+    ASAM_CMP_TRACE_COUNTER("EthernetBatchSize", headers.size());
+
+    for (const auto& [header, offset] : headers)
+    {
+        rawPackets.emplace_back(
+            arena.data() + offset, static_cast<int>(header.caplen), header.ts, false, pcpp::LINKTYPE_ETHERNET);
+        batch.push_back(&rawPackets.back());
+    }
+
+    packetsReceivedCb(batch);
+
+    batch.clear();
+    rawPackets.clear();
+    headers.clear();
+    arena.clear();
+}
+
+void PcapBatchCapture::onPacket(u_char* user, const pcap_pkthdr* header, const u_char* data)
+{
+    auto capture = reinterpret_cast<PcapBatchCapture*>(user);
+    capture->headers.emplace_back(*header, capture->arena.size());
+    capture->arena.insert(capture->arena.end(), data, data + header->caplen);
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,224 @@
+#include <coreobjects/callable_info_factory.h>
+#include <coreobjects/property_factory.h>
+#include <coreobjects/property_object_protected_ptr.h>
+#include <coreobjects/unit_factory.h>
+#include <coretypes/procedure_factory.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include <asam_cmp_common_lib/trace_recorder.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    int64_t getTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    char getPhase(TraceEventType type)
+    {
+        switch (type)
+        {
+            case TraceEventType::begin:
+                return 'B';
+            case TraceEventType::end:
+                return 'E';
+            default:
+                return 'C';
+        }
+    }
+}
+
+TraceRecorder::ThreadBuffer::ThreadBuffer(uint32_t threadId)
+    : threadId(threadId)
+{
+}
+
+struct TraceRecorder::ThreadBufferOwner
+{
+    ~ThreadBufferOwner()
+    {
+        if (buffer != nullptr)
+            TraceRecorder::getInstance().releaseThreadBuffer(buffer);
+    }
+
+    ThreadBuffer* buffer{nullptr};
+};
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::begin(const char* name)
+{
+    record(name, 0, TraceEventType::begin);
+}
+
+void TraceRecorder::end(const char* name)
+{
+    record(name, 0, TraceEventType::end);
+}
+
+void TraceRecorder::counter(const char* name, int64_t value)
+{
+    record(name, value, TraceEventType::counter);
+}
+
+void TraceRecorder::record(const char* name, int64_t value, TraceEventType type)
+{
+    auto& buffer = getThreadBuffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto& slot = buffer.events[head % ringSize];
+
+    slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.timestamp.store(getTimestamp(), std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.type.store(type, std::memory_order_relaxed);
+    slot.sequence.store(2 * head + 2, std::memory_order_release);
+
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::getThreadBuffer()
+{
+    // Buffers outlive their threads so that events of finished threads can still be dumped, and are reused by new threads
+    thread_local ThreadBufferOwner owner;
+    if (owner.buffer == nullptr)
+    {
+        std::scoped_lock lock(buffersSync);
+        if (!freeBuffers.empty())
+        {
+            owner.buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+        else
+        {
+            owner.buffer = buffers.emplace_back(std::make_shared<ThreadBuffer>(static_cast<uint32_t>(buffers.size() + 1))).get();
+        }
+    }
+
+    return *owner.buffer;
+}
+
+void TraceRecorder::releaseThreadBuffer(ThreadBuffer* buffer)
+{
+    std::scoped_lock lock(buffersSync);
+    freeBuffers.push_back(buffer);
+}
+
+void TraceRecorder::writeChromeTrace(std::ostream& stream, std::chrono::nanoseconds duration) const
+{
+    const auto startTime = getTimestamp() - duration.count();
+
+    std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+    {
+        std::scoped_lock lock(buffersSync);
+        threadBuffers = buffers;
+    }
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<TraceEvent> events;
+    for (const auto& buffer : threadBuffers)
+    {
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        const auto tail = head > ringSize ? head - ringSize : 0;
+        events.clear();
+        for (auto i = tail; i < head; ++i)
+        {
+            // The owning thread keeps writing while we copy, events it overwrites meanwhile are dropped
+            const auto& slot = buffer->events[i % ringSize];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * i + 2)
+                continue;
+
+            const TraceEvent event{slot.name.load(std::memory_order_relaxed),
+                                   slot.timestamp.load(std::memory_order_relaxed),
+                                   slot.value.load(std::memory_order_relaxed),
+                                   slot.type.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+                events.push_back(event);
+        }
+
+        for (auto event = events.begin(); event != events.end(); ++event)
+        {
+            if (event->timestamp < startTime)
+                continue;
+
+            stream << (first ? "" : ",") << "{\"name\":\"" << event->name << "\",\"ph\":\"" << getPhase(event->type)
+                   << "\",\"ts\":" << event->timestamp / 1000 << '.' << std::setw(3) << std::setfill('0') << event->timestamp % 1000
+                   << ",\"pid\":1,\"tid\":" << buffer->threadId;
+            if (event->type == TraceEventType::counter)
+                stream << ",\"args\":{\"value\":" << event->value << '}';
+            stream << '}';
+            first = false;
+        }
+    }
+    stream << "]}";
+}
+
+void addTraceProperties(PropertyObjectPtr obj)
+{
+    struct DumpSettings
+    {
+        std::mutex sync;
+        std::string fileName{"asam_cmp_trace.json"};
+        std::chrono::seconds duration{10};
+    };
+
+    auto& recorder = TraceRecorder::getInstance();
+    auto settings = std::make_shared<DumpSettings>();
+
+    obj.addProperty(BoolProperty("Tracing", recorder.isEnabled()));
+    obj.getOnPropertyValueWrite("Tracing") += [&recorder](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        const bool enabled = args.getValue();
+        recorder.setEnabled(enabled);
+    };
+    obj.getOnPropertyValueRead("Tracing") += [&recorder](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(Boolean(recorder.isEnabled())); };
+
+    obj.addProperty(
+        IntPropertyBuilder("TraceDuration", settings->duration.count()).setMinValue(1).setMaxValue(3600).setUnit(Unit("s")).build());
+    obj.getOnPropertyValueWrite("TraceDuration") += [settings](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        std::scoped_lock lock(settings->sync);
+        settings->duration = std::chrono::seconds(static_cast<Int>(args.getValue()));
+    };
+
+    obj.addProperty(StringProperty("TraceFile", settings->fileName));
+    obj.getOnPropertyValueWrite("TraceFile") += [settings](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        const StringPtr fileName = args.getValue();
+        std::scoped_lock lock(settings->sync);
+        settings->fileName = fileName.toStdString();
+    };
+
+    const StringPtr propName = "DumpTrace";
+    obj.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    auto proc = Procedure(
+        [&recorder, settings]()
+        {
+            std::scoped_lock lock(settings->sync);
+            std::ofstream file(settings->fileName);
+            if (!file)
+                throw std::runtime_error("Can't open trace file " + settings->fileName);
+            recorder.writeChromeTrace(file, settings->duration);
+        });
+    obj.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, proc);
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,106 @@
+#include "include/allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<bool> counting{false};
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> bytes{0};
+thread_local bool countedThread{false};
+thread_local bool creatorThread{false};
+
+void* allocate(std::size_t size) noexcept
+{
+    if (counting.load(std::memory_order_relaxed) && (countedThread || creatorThread))
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // namespace
+
+AllocationCounter::AllocationCounter()
+{
+    allocations = 0;
+    bytes = 0;
+    creatorThread = true;
+    counting = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    counting = false;
+    creatorThread = false;
+}
+
+void AllocationCounter::countCurrentThread()
+{
+    countedThread = true;
+}
+
+AllocationStatistics AllocationCounter::getStatistics() const
+{
+    return {allocations.load(), bytes.load()};
+}
+
+// Aligned overloads are left to the runtime, they allocate and free through their own pair of functions
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
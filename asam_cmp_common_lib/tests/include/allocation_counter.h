@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+
+struct AllocationStatistics
+{
+    uint64_t allocations{0};
+    uint64_t bytes{0};
+};
+
+// Counts global operator new calls while the counter is alive. Only the thread that created the counter and threads that
+// called countCurrentThread are counted, so scheduler, timer and status threads don't add noise.
+// Only one counter may be alive at a time.
+class AllocationCounter
+{
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationStatistics getStatistics() const;
+
+    // The calling thread is counted by every counter from now on, for worker threads of the code under test
+    static void countCurrentThread();
+};
+
+// On Windows every DLL has its own operator new, so the allocations made inside the modules are not seen
+#ifdef _WIN32
+#define SKIP_IF_ALLOCATIONS_NOT_COUNTED() GTEST_SKIP() << "Allocations inside module DLLs are not counted on Windows"
+#else
+#define SKIP_IF_ALLOCATIONS_NOT_COUNTED()
+#endif
+
+// Records allocations and bytes per message as test properties and checks them against the budget
+inline void expectAllocationBudget(const AllocationStatistics& statistics,
+                                   size_t messagesCount,
+                                   double maxAllocationsPerMessage,
+                                   double maxBytesPerMessage)
+{
+    ASSERT_GT(messagesCount, 0u);
+
+    const double allocationsPerMessage = static_cast<double>(statistics.allocations) / messagesCount;
+    const double bytesPerMessage = static_cast<double>(statistics.bytes) / messagesCount;
+    ::testing::Test::RecordProperty("AllocationsPerMessage", std::to_string(allocationsPerMessage));
+    ::testing::Test::RecordProperty("BytesPerMessage", std::to_string(bytesPerMessage));
+
+    EXPECT_LE(allocationsPerMessage, maxAllocationsPerMessage);
+    EXPECT_LE(bytesPerMessage, maxBytesPerMessage);
+}
@@ -0,0 +1,156 @@
+#include <PcapLiveDeviceList.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <asam_cmp_common_lib/adapter_session.h>
+
+using daq::asam_cmp_common_lib::AdapterSession;
+using daq::asam_cmp_common_lib::AdapterSessionRegistry;
+using daq::asam_cmp_common_lib::CaptureConfiguration;
+
+TEST(AdapterSessionTest, OneSessionPerDevice)
+{
+    const auto& devices = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDevicesList();
+    if (devices.empty())
+        GTEST_SKIP() << "No network adapters";
+
+    auto& registry = AdapterSessionRegistry::getInstance();
+    auto session = registry.acquire(devices.front(), CaptureConfiguration{});
+    ASSERT_EQ(session->getDevice(), devices.front());
+    ASSERT_EQ(registry.acquire(devices.front(), CaptureConfiguration{}), session);
+
+    std::weak_ptr<AdapterSession> released = session;
+    session.reset();
+    ASSERT_TRUE(released.expired());
+
+    auto newSession = registry.acquire(devices.front(), CaptureConfiguration{});
+    ASSERT_TRUE(newSession);
+    ASSERT_FALSE(newSession->getDevice()->isOpened());
+}
+
+TEST(AdapterSessionTest, FramesAreDeliveredToAllReceivers)
+{
+    auto device = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDeviceByName("lo");
+    if (device == nullptr)
+        GTEST_SKIP() << "No loopback device";
+
+    auto session = AdapterSessionRegistry::getInstance().acquire(device, CaptureConfiguration{});
+    if (!session->open())
+        GTEST_SKIP() << "Loopback device can't be opened";
+
+    std::atomic_size_t firstReceived{0};
+    std::atomic_size_t secondReceived{0};
+    std::atomic_size_t suppressedReceived{0};
+    auto first = session->addReceiver([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { ++firstReceived; }, "", false);
+    auto second = session->addReceiver([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { ++secondReceived; }, "", false);
+    auto suppressed = session->addReceiver([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { ++suppressedReceived; }, "", true);
+
+    const std::vector<uint8_t> data(64, 0x5A);
+    session->send(data);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while ((firstReceived == 0 || secondReceived == 0) && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    session->removeReceiver(first);
+    session->removeReceiver(second);
+    session->removeReceiver(suppressed);
+
+    ASSERT_GT(firstReceived, 0u);
+    ASSERT_EQ(firstReceived, secondReceived);
+    ASSERT_EQ(suppressedReceived, 0u);
+}
+
+TEST(AdapterSessionTest, FramesAreFilteredPerReceiver)
+{
+    auto device = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDeviceByName("lo");
+    if (device == nullptr)
+        GTEST_SKIP() << "No loopback device";
+
+    auto session = AdapterSessionRegistry::getInstance().acquire(device, CaptureConfiguration{});
+    if (!session->open())
+        GTEST_SKIP() << "Loopback device can't be opened";
+
+    std::atomic_size_t matchingReceived{0};
+    std::atomic_size_t otherReceived{0};
+    auto matching =
+        session->addReceiver([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { ++matchingReceived; }, "ether[18] == 0x5A", false);
+    auto other = session->addReceiver([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { ++otherReceived; }, "ether[18] == 1", false);
+
+    const std::vector<uint8_t> data(64, 0x5A);
+    session->send(data);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (matchingReceived == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    session->removeReceiver(matching);
+    session->removeReceiver(other);
+
+    ASSERT_GT(matchingReceived, 0u);
+    ASSERT_EQ(otherReceived, 0u);
+}
+
+TEST(AdapterSessionTest, ConfigurationIsKeptWhileReceiversCapture)
+{
+    auto device = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDeviceByName("lo");
+    if (device == nullptr)
+        GTEST_SKIP() << "No loopback device";
+
+    auto session = AdapterSessionRegistry::getInstance().acquire(device, CaptureConfiguration{});
+    if (!session->open())
+        GTEST_SKIP() << "Loopback device can't be opened";
+
+    CaptureConfiguration configuration;
+    configuration.bufferSize = 4 * 1024 * 1024;
+
+    auto receiver = session->addReceiver([](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) {}, "", false);
+    ASSERT_FALSE(session->setConfiguration(configuration));
+    ASSERT_TRUE(device->captureActive());
+
+    session->removeReceiver(receiver);
+    ASSERT_TRUE(session->setConfiguration(configuration));
+    ASSERT_TRUE(device->isOpened());
+}
+
+TEST(AdapterSessionTest, RemovalDoesNotWaitForOtherReceivers)
+{
+    auto device = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDeviceByName("lo");
+    if (device == nullptr)
+        GTEST_SKIP() << "No loopback device";
+
+    auto session = AdapterSessionRegistry::getInstance().acquire(device, CaptureConfiguration{});
+    if (!session->open())
+        GTEST_SKIP() << "Loopback device can't be opened";
+
+    std::atomic_bool callbackEntered{false};
+    std::atomic_bool callbackReleased{false};
+    auto blocking = session->addReceiver(
+        [&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*)
+        {
+            callbackEntered = true;
+            while (!callbackReleased)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        },
+        "",
+        false);
+    auto other = session->addReceiver([](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) {}, "", false);
+
+    const std::vector<uint8_t> data(64, 0x5A);
+    session->send(data);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!callbackEntered && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // Returns while the callback of the first receiver is still running
+    session->removeReceiver(other);
+    const bool enteredBeforeRemoval = callbackEntered;
+
+    callbackReleased = true;
+    session->removeReceiver(blocking);
+
+    ASSERT_TRUE(enteredBeforeRemoval);
+}
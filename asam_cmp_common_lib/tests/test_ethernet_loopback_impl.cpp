@@ -0,0 +1,91 @@
+#include <RawPacket.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+
+using namespace std::chrono_literals;
+using daq::asam_cmp_common_lib::CaptureConfiguration;
+using daq::asam_cmp_common_lib::EthernetLoopbackImpl;
+
+class EthernetLoopbackImplTest : public ::testing::Test
+{
+protected:
+    void onPacket(pcpp::RawPacket* packet)
+    {
+        std::scoped_lock lock(sync);
+        frames.emplace_back(packet->getRawData(), packet->getRawData() + packet->getRawDataLen());
+        cv.notify_all();
+    }
+
+    bool waitForFrames(size_t count)
+    {
+        std::unique_lock lock(sync);
+        return cv.wait_for(lock, 1s, [this, count] { return frames.size() >= count; });
+    }
+
+protected:
+    EthernetLoopbackImpl loopback{4};
+
+    std::mutex sync;
+    std::condition_variable cv;
+    std::vector<std::vector<uint8_t>> frames;
+};
+
+TEST_F(EthernetLoopbackImplTest, DeviceList)
+{
+    ASSERT_EQ(loopback.getEthernetDevicesNamesList().getCount(), 1u);
+    ASSERT_TRUE(loopback.setDevice(loopback.getEthernetDevicesNamesList()[0]));
+    ASSERT_FALSE(loopback.setDevice("eth0"));
+}
+
+TEST_F(EthernetLoopbackImplTest, DeliversFramesWithEthernetHeader)
+{
+    loopback.startCapture([this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice*, void*) { onPacket(packet); });
+    ASSERT_TRUE(loopback.isDeviceCapturing());
+
+    const std::vector<uint8_t> data{1, 2, 3};
+    loopback.sendPacket(data);
+    ASSERT_TRUE(waitForFrames(1));
+    loopback.stopCapture();
+    ASSERT_FALSE(loopback.isDeviceCapturing());
+
+    ASSERT_EQ(frames[0].size(), 14u + data.size());
+    ASSERT_EQ(frames[0][12], 0x99);
+    ASSERT_EQ(frames[0][13], 0xFE);
+    ASSERT_TRUE(std::equal(data.begin(), data.end(), frames[0].begin() + 14));
+    ASSERT_EQ(loopback.getCaptureStatistics().received, 1u);
+}
+
+TEST_F(EthernetLoopbackImplTest, BatchCapture)
+{
+    CaptureConfiguration configuration;
+    configuration.batchSize = 2;
+    loopback.setCaptureConfiguration(configuration);
+
+    size_t maxBatchSize = 0;
+    loopback.startBatchCapture(
+        [this, &maxBatchSize](const std::vector<pcpp::RawPacket*>& packets)
+        {
+            maxBatchSize = std::max(maxBatchSize, packets.size());
+            for (auto* packet : packets)
+                onPacket(packet);
+        });
+
+    for (uint8_t i = 0; i < 3; ++i)
+        loopback.sendPacket({i});
+    ASSERT_TRUE(waitForFrames(3));
+    loopback.stopCapture();
+
+    ASSERT_LE(maxBatchSize, 2u);
+    ASSERT_EQ(frames[2][14], 2);
+}
+
+TEST_F(EthernetLoopbackImplTest, NotCapturing)
+{
+    loopback.sendPacket({1});
+    ASSERT_EQ(loopback.getCaptureStatistics().received, 0u);
+    ASSERT_EQ(loopback.getCaptureStatistics().droppedByKernel, 0u);
+}
@@ -0,0 +1,87 @@
+#include <PcapLiveDeviceList.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include "include/allocation_counter.h"
+
+using daq::StringPtr;
+using daq::asam_cmp_common_lib::EthernetPcppImpl;
+
+TEST(EthernetPcppImplTest, EnumeratesWithoutOpening)
+{
+    EthernetPcppImpl ethernet;
+    const auto names = ethernet.getEthernetDevicesNamesList();
+    const auto descriptions = ethernet.getEthernetDevicesDescriptionsList();
+    ASSERT_EQ(names.getCount(), descriptions.getCount());
+
+    const auto& devices = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDevicesList();
+    ASSERT_EQ(names.getCount(), devices.size());
+    ASSERT_TRUE(std::none_of(devices.begin(), devices.end(), [](const auto& device) { return device->isOpened(); }));
+}
+
+TEST(EthernetPcppImplTest, ActiveDeviceIsReportedWithoutOpening)
+{
+    EthernetPcppImpl ethernet;
+    const auto names = ethernet.getEthernetDevicesNamesList();
+    if (names.getCount() == 0)
+        GTEST_SKIP() << "No network adapters";
+
+    ASSERT_EQ(ethernet.getActiveDeviceName(), names[0]);
+    if (ethernet.setDevice("lo"))
+        ASSERT_EQ(ethernet.getActiveDeviceName(), "lo");
+}
+
+TEST(EthernetPcppImplTest, ReselectingKeepsDeviceOpen)
+{
+    EthernetPcppImpl ethernet;
+    if (!ethernet.setDevice("lo"))
+        GTEST_SKIP() << "Loopback device can't be opened";
+
+    auto device = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDeviceByName("lo");
+    ASSERT_TRUE(device->isOpened());
+
+    const auto names = ethernet.getEthernetDevicesNamesList();
+    const auto otherName = std::find_if(names.begin(), names.end(), [](const StringPtr& name) { return name != "lo"; });
+    if (otherName != names.end())
+        ethernet.setDevice(*otherName);
+
+    ASSERT_TRUE(device->isOpened());
+    ASSERT_TRUE(ethernet.setDevice("lo"));
+}
+
+TEST(EthernetPcppImplTest, InvalidCaptureFilterIsRejected)
+{
+    EthernetPcppImpl ethernet;
+    ASSERT_TRUE(ethernet.setCaptureFilter("ether[18] == 3 or ether[18] == 255"));
+    ASSERT_FALSE(ethernet.setCaptureFilter("ether[18] == == 3"));
+    ASSERT_TRUE(ethernet.setCaptureFilter(""));
+}
+
+TEST(EthernetPcppImplTest, SendPacketDoesNotAllocate)
+{
+    SKIP_IF_ALLOCATIONS_NOT_COUNTED();
+
+    EthernetPcppImpl ethernet;
+    if (!ethernet.setDevice("lo"))
+        GTEST_SKIP() << "Loopback device can't be opened";
+
+    std::vector<uint8_t> data(1000);
+    std::iota(data.begin(), data.end(), uint8_t{0});
+
+    constexpr size_t warmUpCount = 10;
+    for (size_t i = 0; i < warmUpCount; ++i)
+        ethernet.sendPacket(data);
+
+    constexpr size_t messagesCount = 1000;
+    AllocationStatistics statistics;
+    {
+        AllocationCounter counter;
+        for (size_t i = 0; i < messagesCount; ++i)
+            ethernet.sendPacket(data);
+        statistics = counter.getStatistics();
+    }
+
+    expectAllocationBudget(statistics, messagesCount, 0, 0);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/id_manager.h>
+
+using daq::asam_cmp_common_lib::FreeIdsBitmap;
+using daq::asam_cmp_common_lib::FreeIdsIntervals;
+using daq::asam_cmp_common_lib::IdManager;
+
+template <typename T>
+class IdManagerTest : public ::testing::Test
+{
+};
+
+using IdTypes = ::testing::Types<uint8_t, uint16_t, uint32_t>;
+TYPED_TEST_SUITE(IdManagerTest, IdTypes);
+
+TYPED_TEST(IdManagerTest, FirstUnusedIdStartsFromOne)
+{
+    IdManager<TypeParam> manager;
+    ASSERT_EQ(manager.getFirstUnusedId(), TypeParam{1});
+
+    manager.addId(0);
+    ASSERT_EQ(manager.getFirstUnusedId(), TypeParam{1});
+
+    for (TypeParam id = 1; id <= 100; ++id)
+    {
+        ASSERT_EQ(manager.getFirstUnusedId(), id);
+        manager.addId(id);
+    }
+}
+
+TYPED_TEST(IdManagerTest, RemovedIdIsReused)
+{
+    IdManager<TypeParam> manager;
+    for (TypeParam id = 1; id <= 100; ++id)
+        manager.addId(id);
+
+    manager.removeId(70);
+    manager.removeId(30);
+    ASSERT_EQ(manager.getFirstUnusedId(), TypeParam{30});
+    manager.addId(30);
+    ASSERT_EQ(manager.getFirstUnusedId(), TypeParam{70});
+    manager.addId(70);
+    ASSERT_EQ(manager.getFirstUnusedId(), TypeParam{101});
+}
+
+TYPED_TEST(IdManagerTest, ValidIds)
+{
+    IdManager<TypeParam> manager;
+    manager.addId(5);
+
+    ASSERT_FALSE(manager.isValidId(-1));
+    ASSERT_FALSE(manager.isValidId(5));
+    ASSERT_TRUE(manager.isValidId(0));
+    ASSERT_TRUE(manager.isValidId(6));
+    ASSERT_TRUE(manager.isValidId(std::numeric_limits<TypeParam>::max()));
+    ASSERT_FALSE(manager.isValidId(int64_t{std::numeric_limits<TypeParam>::max()} + 1));
+
+    manager.removeId(5);
+    ASSERT_TRUE(manager.isValidId(5));
+}
+
+TYPED_TEST(IdManagerTest, AddingAndRemovingTwiceIsIgnored)
+{
+    IdManager<TypeParam> manager;
+    manager.addId(1);
+    manager.addId(1);
+    manager.removeId(1);
+    ASSERT_TRUE(manager.isValidId(1));
+
+    manager.removeId(1);
+    manager.addId(1);
+    ASSERT_FALSE(manager.isValidId(1));
+    ASSERT_EQ(manager.getFirstUnusedId(), TypeParam{2});
+}
+
+TEST(IdManagerTest, StreamIdsExhausted)
+{
+    IdManager<uint8_t> manager;
+    for (int id = 1; id <= 255; ++id)
+        manager.addId(static_cast<uint8_t>(id));
+
+    ASSERT_EQ(manager.getFirstUnusedId(), uint8_t{0});
+    manager.removeId(200);
+    ASSERT_EQ(manager.getFirstUnusedId(), uint8_t{200});
+}
+
+TEST(IdManagerTest, BitmapFindsFreeIdAcrossWords)
+{
+    FreeIdsBitmap<uint16_t> bitmap;
+    for (uint32_t id = 0; id < 5000; ++id)
+        bitmap.setUsed(static_cast<uint16_t>(id));
+
+    ASSERT_EQ(bitmap.findFree(0), 5000);
+    bitmap.setFree(4097);
+    ASSERT_EQ(bitmap.findFree(0), 4097);
+    ASSERT_EQ(bitmap.findFree(4098), 5000);
+    ASSERT_EQ(bitmap.findFree(65535), 65535);
+
+    bitmap.setUsed(65535);
+    ASSERT_FALSE(bitmap.findFree(65535).has_value());
+}
+
+TEST(IdManagerTest, IntervalsMergeOnRelease)
+{
+    FreeIdsIntervals<uint32_t> intervals;
+    for (uint32_t id = 10; id < 20; ++id)
+        intervals.setUsed(id);
+
+    ASSERT_EQ(intervals.findFree(10), 20u);
+    intervals.setFree(12);
+    intervals.setFree(14);
+    intervals.setFree(13);
+    ASSERT_EQ(intervals.findFree(10), 12u);
+    ASSERT_EQ(intervals.findFree(15), 20u);
+    ASSERT_TRUE(intervals.isFree(13));
+    ASSERT_FALSE(intervals.isFree(15));
+
+    intervals.setUsed(std::numeric_limits<uint32_t>::max());
+    ASSERT_FALSE(intervals.isFree(std::numeric_limits<uint32_t>::max()));
+    ASSERT_TRUE(intervals.isFree(std::numeric_limits<uint32_t>::max() - 1));
+}
+
+TEST(IdManagerTest, ManyInterfaceIds)
+{
+    constexpr uint32_t idsCount = 200000;
+    IdManager<uint32_t> manager;
+    for (uint32_t i = 0; i < idsCount; ++i)
+        manager.addId(manager.getFirstUnusedId());
+
+    ASSERT_EQ(manager.getFirstUnusedId(), idsCount + 1);
+    manager.removeId(idsCount / 2);
+    ASSERT_EQ(manager.getFirstUnusedId(), idsCount / 2);
+}
@@ -0,0 +1,48 @@
+#include <gmock/gmock.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+
+using daq::asam_cmp_common_lib::LatencyHistogram;
+
+TEST(LatencyHistogramTest, Empty)
+{
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getCount(), 0u);
+    ASSERT_EQ(histogram.getMax(), 0u);
+    ASSERT_EQ(histogram.getPercentile(50.0), 0u);
+}
+
+TEST(LatencyHistogramTest, BucketBounds)
+{
+    uint64_t previousUpperBound = 0;
+    for (size_t i = 1; i < LatencyHistogram::bucketsCount; ++i)
+    {
+        const auto upperBound = LatencyHistogram::getBucketUpperBound(i);
+        ASSERT_GT(upperBound, previousUpperBound);
+        ASSERT_EQ(LatencyHistogram::getBucketIndex(upperBound), i);
+        ASSERT_EQ(LatencyHistogram::getBucketIndex(previousUpperBound + 1), i);
+        previousUpperBound = upperBound;
+    }
+    ASSERT_EQ(previousUpperBound, std::numeric_limits<uint64_t>::max());
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; ++value)
+        histogram.record(value * 1000);
+
+    ASSERT_EQ(histogram.getCount(), 1000u);
+    ASSERT_EQ(histogram.getMax(), 1000000u);
+    ASSERT_NEAR(static_cast<double>(histogram.getPercentile(50.0)), 500000.0, 500000.0 * 0.07);
+    ASSERT_NEAR(static_cast<double>(histogram.getPercentile(99.0)), 990000.0, 990000.0 * 0.07);
+    ASSERT_EQ(histogram.getPercentile(100.0), 1000000u);
+}
+
+TEST(LatencyHistogramTest, Reset)
+{
+    LatencyHistogram histogram;
+    histogram.record(42);
+    histogram.reset();
+    ASSERT_EQ(histogram.getCount(), 0u);
+    ASSERT_EQ(histogram.getMax(), 0u);
+}
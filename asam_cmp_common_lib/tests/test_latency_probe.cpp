@@ -0,0 +1,38 @@
+#include <gmock/gmock.h>
+#include <asam_cmp_common_lib/latency_probe.h>
+
+using daq::asam_cmp_common_lib::LatencyProbe;
+using daq::asam_cmp_common_lib::decodeLatencyProbe;
+using daq::asam_cmp_common_lib::encodeLatencyProbe;
+
+TEST(LatencyProbeTest, EncodeDecode)
+{
+    LatencyProbe probe{0x1234, 0xABCD, 1'700'000'000'123'456'789};
+    const auto data = encodeLatencyProbe(probe);
+    ASSERT_EQ(data.size(), daq::asam_cmp_common_lib::latencyProbeSize);
+    ASSERT_EQ(data[2], 0x12);
+    ASSERT_EQ(data[3], 0x34);
+    ASSERT_EQ(data[4], daq::asam_cmp_common_lib::latencyProbeMessageType);
+
+    LatencyProbe decoded;
+    ASSERT_TRUE(decodeLatencyProbe(data.data(), data.size(), decoded));
+    ASSERT_EQ(decoded.deviceId, probe.deviceId);
+    ASSERT_EQ(decoded.sequenceCounter, probe.sequenceCounter);
+    ASSERT_EQ(decoded.txTime, probe.txTime);
+}
+
+TEST(LatencyProbeTest, RejectOtherMessages)
+{
+    auto data = encodeLatencyProbe({1, 2, 3});
+    LatencyProbe decoded;
+
+    ASSERT_FALSE(decodeLatencyProbe(data.data(), data.size() - 1, decoded));
+
+    auto otherType = data;
+    otherType[4] = 0x01;
+    ASSERT_FALSE(decodeLatencyProbe(otherType.data(), otherType.size(), decoded));
+
+    auto otherMagic = data;
+    otherMagic[10] = 'X';
+    ASSERT_FALSE(decodeLatencyProbe(otherMagic.data(), otherMagic.size(), decoded));
+}
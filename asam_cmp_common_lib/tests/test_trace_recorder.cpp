@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include <asam_cmp_common_lib/trace_recorder.h>
+
+using namespace std::chrono_literals;
+using daq::asam_cmp_common_lib::TraceRecorder;
+using daq::asam_cmp_common_lib::TraceScope;
+
+class TraceRecorderTest : public ::testing::Test
+{
+protected:
+    static size_t countOccurrences(const std::string& text, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+            ++count;
+        return count;
+    }
+
+    static std::string getThreadId(const std::string& trace, size_t pos)
+    {
+        const auto begin = trace.find("\"tid\":", pos);
+        return trace.substr(begin, trace.find_first_of(",}", begin) - begin);
+    }
+
+    std::string dump(std::chrono::nanoseconds duration = 1h) const
+    {
+        std::ostringstream stream;
+        recorder.writeChromeTrace(stream, duration);
+        return stream.str();
+    }
+
+protected:
+    TraceRecorder& recorder{TraceRecorder::getInstance()};
+};
+
+TEST_F(TraceRecorderTest, BeginEndAndCounterEvents)
+{
+    recorder.begin("TraceRecorderTestScope");
+    recorder.counter("TraceRecorderTestCounter", 42);
+    recorder.end("TraceRecorderTestScope");
+
+    const auto trace = dump();
+    ASSERT_EQ(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    ASSERT_EQ(trace.back(), '}');
+    ASSERT_EQ(countOccurrences(trace, "{\"name\":\"TraceRecorderTestScope\",\"ph\":\"B\""), 1u);
+    ASSERT_EQ(countOccurrences(trace, "{\"name\":\"TraceRecorderTestScope\",\"ph\":\"E\""), 1u);
+    ASSERT_EQ(countOccurrences(trace, "{\"name\":\"TraceRecorderTestCounter\",\"ph\":\"C\""), 1u);
+    ASSERT_EQ(countOccurrences(trace, "\"args\":{\"value\":42}"), 1u);
+}
+
+TEST_F(TraceRecorderTest, KeepsLatestEventsOfThread)
+{
+    std::thread([this]
+                {
+                    recorder.counter("TraceRecorderTestOverwritten", 0);
+                    for (size_t i = 0; i < TraceRecorder::ringSize; ++i)
+                        recorder.counter("TraceRecorderTestLatest", static_cast<int64_t>(i));
+                })
+        .join();
+
+    const auto trace = dump();
+    ASSERT_EQ(countOccurrences(trace, "TraceRecorderTestOverwritten"), 0u);
+    ASSERT_EQ(countOccurrences(trace, "TraceRecorderTestLatest"), TraceRecorder::ringSize);
+}
+
+TEST_F(TraceRecorderTest, ThreadsGetOwnTrack)
+{
+    // Both threads are alive until both have recorded, so neither can get the buffer of the other
+    std::atomic_size_t recorded{0};
+    auto recordOnThread = [this, &recorded]
+    {
+        recorder.counter("TraceRecorderTestThread", 1);
+        ++recorded;
+        while (recorded < 2)
+            std::this_thread::yield();
+    };
+    std::thread first(recordOnThread);
+    std::thread second(recordOnThread);
+    first.join();
+    second.join();
+
+    const auto trace = dump();
+    const auto firstPos = trace.find("TraceRecorderTestThread");
+    const auto secondPos = trace.find("TraceRecorderTestThread", firstPos + 1);
+    ASSERT_NE(secondPos, std::string::npos);
+    ASSERT_NE(getThreadId(trace, firstPos), getThreadId(trace, secondPos));
+}
+
+TEST_F(TraceRecorderTest, BufferOfExitedThreadIsReused)
+{
+    std::thread([this] { recorder.counter("TraceRecorderTestExited", 1); }).join();
+    std::thread([this] { recorder.counter("TraceRecorderTestReusing", 1); }).join();
+
+    const auto trace = dump();
+    const auto exitedPos = trace.find("TraceRecorderTestExited");
+    const auto reusingPos = trace.find("TraceRecorderTestReusing");
+    ASSERT_NE(exitedPos, std::string::npos);
+    ASSERT_NE(reusingPos, std::string::npos);
+    ASSERT_EQ(getThreadId(trace, exitedPos), getThreadId(trace, reusingPos));
+}
+
+TEST_F(TraceRecorderTest, DumpsOnlyRequestedDuration)
+{
+    recorder.counter("TraceRecorderTestOld", 1);
+    std::this_thread::sleep_for(50ms);
+    recorder.counter("TraceRecorderTestNew", 1);
+
+    const auto trace = dump(20ms);
+    ASSERT_EQ(countOccurrences(trace, "TraceRecorderTestOld"), 0u);
+    ASSERT_EQ(countOccurrences(trace, "TraceRecorderTestNew"), 1u);
+}
+
+TEST_F(TraceRecorderTest, EnabledSwitch)
+{
+    ASSERT_FALSE(recorder.isEnabled());
+    recorder.setEnabled(true);
+    ASSERT_TRUE(recorder.isEnabled());
+    recorder.setEnabled(false);
+    ASSERT_FALSE(recorder.isEnabled());
+}
+
+TEST_F(TraceRecorderTest, ScopeRecordsOnlyWhenEnabled)
+{
+    {
+        TraceScope scope("TraceRecorderTestDisabledScope");
+    }
+
+    recorder.setEnabled(true);
+    {
+        TraceScope scope("TraceRecorderTestEnabledScope");
+    }
+    recorder.setEnabled(false);
+
+    const auto trace = dump();
+    ASSERT_EQ(countOccurrences(trace, "TraceRecorderTestDisabledScope"), 0u);
+    ASSERT_EQ(countOccurrences(trace, "TraceRecorderTestEnabledScope"), 2u);
+}
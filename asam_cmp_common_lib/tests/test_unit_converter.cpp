@@ -10,3 +10,21 @@ TEST(UnitConverterTest, UnitConverterTest)
         ASSERT_EQ((sym.empty() ? (uint8_t)0 : i), getIdBySymbol(sym));
     }
 }
+
+TEST(UnitConverterTest, NonAsciiSymbols)
+{
+    static_assert(getIdBySymbol("°C") == 0x17);
+    static_assert(getIdBySymbol("m/s²") == 0x1F);
+    static_assert(getSymbolById(0x26) == "m²");
+
+    ASSERT_EQ(getIdBySymbol(std::string("m/s⁴")), 0x21);
+}
+
+TEST(UnitConverterTest, UnknownSymbols)
+{
+    static_assert(getIdBySymbol("") == 0);
+    ASSERT_EQ(getIdBySymbol("furlong"), 0);
+    ASSERT_EQ(getIdBySymbol("m/s5"), 0);
+    ASSERT_TRUE(getSymbolById(0x55).empty());
+    ASSERT_TRUE(getSymbolById(0xFF).empty());
+}
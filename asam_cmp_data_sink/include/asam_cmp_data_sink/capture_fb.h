@@ -24,22 +24,29 @@
 #include <asam_cmp_data_sink/capture_packets_publisher.h>
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
+#include <asam_cmp_data_sink/status_handler.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
-class CaptureFb final : public asam_cmp_common_lib::CaptureCommonFbImpl<IAsamCmpPacketsSubscriber>
+class CaptureFb final : public asam_cmp_common_lib::CaptureCommonFbImpl<IAsamCmpPacketsSubscriber, IDeviceStatusSync>
 {
 public:
     explicit CaptureFb(const ContextPtr& ctx,
                        const ComponentPtr& parent,
                        const StringPtr& localId,
                        DataPacketsPublisher& publisher,
-                       CapturePacketsPublisher& capturePacketsPublisher);
+                       CapturePacketsPublisher& capturePacketsPublisher,
+                       SequenceTracker& sequenceTracker,
+                       LatencyProbeTracker& latencyProbeTracker);
     explicit CaptureFb(const ContextPtr& ctx,
                        const ComponentPtr& parent,
                        const StringPtr& localId,
                        DataPacketsPublisher& publisher,
                        CapturePacketsPublisher& capturePacketsPublisher,
+                       SequenceTracker& sequenceTracker,
+                       LatencyProbeTracker& latencyProbeTracker,
                        ASAM::CMP::DeviceStatus&& deviceStatus);
     ~CaptureFb() override = default;
 
@@ -47,12 +54,16 @@ public:
     void receive(const std::shared_ptr<ASAM::CMP::Packet>& packet) override;
     void receive(const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& packets) override{};
 
+    // IDeviceStatusSync
+    void syncWithStatus(const ASAM::CMP::DeviceStatus& newStatus) override;
+
 protected:
     void updateDeviceIdInternal() override;
     void addInterfaceInternal() override;
     void removeInterfaceInternal(size_t nInd) override;
 
 private:
+    void initStatisticsProperties();
     void setProperties();
     void setDeviceInfoProperties(const ASAM::CMP::Packet& packet);
     void createFbs();
@@ -61,6 +72,8 @@ private:
     ASAM::CMP::DeviceStatus deviceStatus;
     DataPacketsPublisher& dataPacketsPublisher;
     CapturePacketsPublisher& capturePacketsPublisher;
+    SequenceTracker& sequenceTracker;
+    LatencyProbeTracker& latencyProbeTracker;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp/status.h>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_data_sink/data_packets_publisher.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Builds a BPF expression that lets through status messages, latency probes and data messages of subscribed endpoints only.
+// Offsets assume an untagged Ethernet frame followed by the CMP header and the first data message header.
+std::string createCaptureFilter(const std::vector<Endpoint>& endpoints);
+
+// Returns the (deviceId, streamId) pairs whose data messages pass the capture filter on every interface that lists the
+// stream in the status. Only for these the CMP sequence counter, which is shared by the interfaces, is seen in full.
+std::set<std::pair<uint16_t, uint8_t>> getFullyCapturedStreams(const std::vector<Endpoint>& endpoints, const ASAM::CMP::Status& status);
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
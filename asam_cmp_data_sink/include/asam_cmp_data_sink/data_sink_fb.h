@@ -17,15 +17,18 @@
 #pragma once
 #include <asam_cmp/status.h>
 #include <opendaq/function_block_impl.h>
+#include <atomic>
 
 #include <asam_cmp_data_sink/capture_packets_publisher.h>
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
 #include <asam_cmp_data_sink/status_handler.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
-class DataSinkFb final : public FunctionBlock
+class DataSinkFb final : public FunctionBlockImpl<IFunctionBlock, IStatusListener>
 {
 public:
     explicit DataSinkFb(const ContextPtr& ctx,
@@ -33,13 +36,21 @@ public:
                         const StringPtr& localId,
                         StatusMt statusMt,
                         DataPacketsPublisher& dataPacketsPublisher,
-                        CapturePacketsPublisher& capturePacketsPublisher);
+                        CapturePacketsPublisher& capturePacketsPublisher,
+                        SequenceTracker& sequenceTracker,
+                        LatencyProbeTracker& latencyProbeTracker);
     ~DataSinkFb() override = default;
 
     static FunctionBlockTypePtr CreateType();
 
+public:
+    // IStatusListener
+    void statusChanged() override;
+
 private:
     void initProperties();
+    void syncWithStatus();
+    void addCaptureModule(ASAM::CMP::DeviceStatus&& deviceStatus);
     void addCaptureModuleFromStatus(int index);
     void addCaptureModuleEmpty();
     void removeCaptureModule(int fbIndex);
@@ -48,9 +59,12 @@ private:
 
 private:
     size_t captureModuleId{0};
+    std::atomic_bool autoSync{false};
     StatusMt status;
     DataPacketsPublisher& dataPacketsPublisher;
     CapturePacketsPublisher& capturePacketsPublisher;
+    SequenceTracker& sequenceTracker;
+    LatencyProbeTracker& latencyProbeTracker;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
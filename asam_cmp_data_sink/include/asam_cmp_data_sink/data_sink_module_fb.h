@@ -17,11 +17,18 @@
 #pragma once
 #include <PcapLiveDeviceList.h>
 #include <asam_cmp/decoder.h>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 #include <asam_cmp_common_lib/network_manager_fb.h>
 
 #include <asam_cmp_data_sink/capture_packets_publisher.h>
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
+#include <asam_cmp_data_sink/status_cache.h>
+#include <asam_cmp_data_sink/status_handler.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
@@ -39,20 +46,61 @@ public:
     ErrCode INTERFACE_FUNC remove() override;
 
 private:
+    void initCaptureConfigurationProperties();
+    void addCaptureConfigurationProperty(const StringPtr& propName, int asam_cmp_common_lib::CaptureConfiguration::*field, Int maxValue);
+    void applyCaptureConfiguration();
+    void initStatisticsProperties();
+    void initStatusCacheProperties();
+    void updateStatusCache();
+    void restoreStatus(const StatusCache& cache);
+    void processStatusChange();
+    void requestStatusChange();
+    void statusChangeLoop();
+    void stopStatusChangeThread();
     void createFbs();
     void startCapture();
     void stopCapture();
+    void updateCaptureFilter();
+    void updateLossTracking(const std::vector<Endpoint>& endpoints);
     void onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie);
+    void onPacketsArrive(const std::vector<pcpp::RawPacket*>& packets);
     std::vector<std::shared_ptr<ASAM::CMP::Packet>> decode(pcpp::RawPacket* packet);
+    bool processLatencyProbe(const pcpp::RawPacket* packet, const uint8_t* data, size_t size);
 
     void networkAdapterChangedInternal() override;
 
 private:
     bool captureStartedOnThisFb;
+    asam_cmp_common_lib::CaptureConfiguration captureConfiguration;
+    asam_cmp_common_lib::CaptureMode captureMode{asam_cmp_common_lib::CaptureMode::perPacket};
     ASAM::CMP::Decoder decoder;
+    ObjectPtr<IStatusHandler> statusHandler;
+    ObjectPtr<IStatusListener> statusListener;
 
     DataPacketsPublisher dataPacketsPublisher;
     CapturePacketsPublisher capturePacketsPublisher;
+    SequenceTracker sequenceTracker;
+    LatencyProbeTracker latencyProbeTracker;
+
+    std::mutex captureFilterSync;
+    std::string captureFilter;
+
+    std::mutex statusCacheSync;
+    bool statusCacheEnabled{false};
+    std::string statusCacheDirectory{"."};
+    // Read by the capture thread with an atomic load, nullptr while caching is disabled
+    std::shared_ptr<const StatusCache> statusCache;
+
+    std::mutex statusChangeSync;
+    uint64_t processedStatusVersion{0};
+
+    // Status changes of received messages are processed here, as the Data Sink FB creates and removes FBs and subscriptions
+    // which update the filter of the capture that is delivering the messages
+    std::mutex statusChangeRequestSync;
+    std::condition_variable statusChangeRequested;
+    bool statusChangePending{false};
+    bool stopStatusChanges{false};
+    std::thread statusChangeThread;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Module-wide timer for the flush deadlines of pending sink data. The thread sleeps while nothing is scheduled.
+class FlushTimer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using FlushCallback = std::function<void(Clock::time_point)>;
+
+    static std::shared_ptr<FlushTimer> getInstance();
+
+    FlushTimer();
+    ~FlushTimer();
+
+    // Calls the callback once from the timer thread when the deadline has passed. A new deadline of the same owner
+    // replaces the pending one. Callbacks are invoked without the timer lock, so they may schedule and cancel.
+    void schedule(const void* owner, Clock::time_point deadline, FlushCallback callback);
+    // After return the callback of the owner is not running and won't be called again, unless it is called from a
+    // callback on the timer thread
+    void cancel(const void* owner);
+
+private:
+    struct Entry
+    {
+        const void* owner;
+        Clock::time_point deadline;
+        FlushCallback callback;
+    };
+
+    void timerLoop();
+
+private:
+    std::mutex sync;
+    std::condition_variable cv;
+    std::vector<Entry> entries;
+    bool stopTimer{false};
+    // Held while the due callbacks run, the due list is only touched by the timer thread
+    std::mutex callbackSync;
+    std::vector<Entry> dueEntries;
+    std::thread timerThread;
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -19,6 +19,7 @@
 
 #include <asam_cmp_common_lib/interface_common_fb.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
@@ -30,17 +31,21 @@ public:
                          const StringPtr& localId,
                          const asam_cmp_common_lib::InterfaceCommonInit& init,
                          const uint16_t& deviceId,
-                         DataPacketsPublisher& publisher);
+                         DataPacketsPublisher& publisher,
+                         SequenceTracker& sequenceTracker);
     explicit InterfaceFb(const ContextPtr& ctx,
                          const ComponentPtr& parent,
                          const StringPtr& localId,
                          const asam_cmp_common_lib::InterfaceCommonInit& init,
                          const uint16_t& deviceId,
                          DataPacketsPublisher& publisher,
+                         SequenceTracker& sequenceTracker,
                          ASAM::CMP::InterfaceStatus&& ifStatus);
 
     ~InterfaceFb() override = default;
 
+    void syncWithStatus(const ASAM::CMP::InterfaceStatus& newStatus);
+
 protected:
     void updateInterfaceIdInternal() override;
     void addStreamInternal() override;
@@ -48,10 +53,12 @@ protected:
 
 private:
     void createFbs();
+    void addStreamWithId(uint8_t streamId);
 
 private:
     ASAM::CMP::InterfaceStatus interfaceStatus;
     DataPacketsPublisher& publisher;
+    SequenceTracker& sequenceTracker;
     const uint16_t& deviceId;
 };
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <coreobjects/property_object_ptr.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Latencies in ns over the last LatencyProbeTracker::windowSize probes. Transport latency is the pcap RX timestamp
+// minus the probe TX time and is only meaningful over loopback or between synchronized clocks, so it can be negative.
+struct LatencyProbeStatistics
+{
+    uint64_t received{0};
+    int64_t transportP50{0};
+    int64_t transportP99{0};
+    int64_t transportMax{0};
+    int64_t processingP50{0};
+    int64_t processingP99{0};
+    int64_t processingMax{0};
+};
+
+// Keeps a rolling window of latency probe results for every capture module device id
+class LatencyProbeTracker final
+{
+public:
+    void record(uint16_t deviceId, int64_t transportLatency, int64_t processingLatency);
+    LatencyProbeStatistics getStatistics(uint16_t deviceId) const;
+
+public:
+    static constexpr size_t windowSize = 1024;
+
+private:
+    struct DeviceEntry
+    {
+        std::array<int64_t, windowSize> transport{};
+        std::array<int64_t, windowSize> processing{};
+        uint64_t received{0};
+    };
+
+    mutable std::mutex sync;
+    std::unordered_map<uint16_t, DeviceEntry> devices;
+};
+
+// Adds read-only LatencyProbesReceived, ProbeTransportLatencyP50, P99, Max and ProbeProcessingLatencyP50, P99, Max
+// properties whose values are taken from getStatistics on every read
+void addLatencyProbeProperties(PropertyObjectPtr obj, std::function<LatencyProbeStatistics()> getStatistics);
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Size-classed buffer cache for packets created with external memory. Buffers are returned by the packet deleter
+// from any thread, so the pool must outlive every packet that references it.
+class PacketBufferPool final
+{
+public:
+    PacketBufferPool() = default;
+    ~PacketBufferPool();
+
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+
+    void* allocate(size_t size);
+    void release(void* address);
+
+    size_t getCachedBuffersCount() const;
+
+private:
+    static size_t getSizeClass(size_t size);
+
+public:
+    static constexpr size_t minBufferSize = 64;
+    static constexpr size_t sizeClassesCount = 15;
+    static constexpr size_t maxCachedBuffersPerClass = 32;
+
+private:
+    mutable std::mutex sync;
+    std::array<std::vector<void*>, sizeClassesCount> freeBuffers;
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
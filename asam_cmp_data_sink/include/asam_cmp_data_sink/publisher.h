@@ -19,6 +19,8 @@
 #include <coretypes/baseobject.h>
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <unordered_set>
 
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/asam_cmp_packets_subscriber.h>
@@ -29,25 +31,61 @@ template <typename Topic, typename Subscriber, class TopicHasher = std::hash<Top
 class Publisher final
 {
 public:
+    using SubscriptionsChangedHandler = std::function<void()>;
+
     auto subscribe(const Topic& topic, Subscriber* subscriber)
     {
-        std::scoped_lock lock(subscribersMt);
-
-        return subscribers.insert({topic, subscriber});
+        SubscriptionsChangedHandler handler;
+        auto result = [&]
+        {
+            std::scoped_lock lock(subscribersMt);
+            handler = subscriptionsChangedHandler;
+            return subscribers.insert({topic, subscriber});
+        }();
+
+        if (handler)
+            handler();
+        return result;
     }
 
     void unsubscribe(const Topic& topic, Subscriber* subscriber)
     {
-        std::scoped_lock lock(subscribersMt);
+        SubscriptionsChangedHandler handler;
+        {
+            std::scoped_lock lock(subscribersMt);
 
-        auto range = subscribers.equal_range(topic);
-        if (range.first == subscribers.end() && range.second == subscribers.end())
-            return;
+            auto range = subscribers.equal_range(topic);
+            if (range.first == subscribers.end() && range.second == subscribers.end())
+                return;
 
-        auto it = std::find_if(range.first, range.second, [subscriber](const auto& val) { return val.second == subscriber; });
+            auto it = std::find_if(range.first, range.second, [subscriber](const auto& val) { return val.second == subscriber; });
+            if (it == range.second)
+                return;
 
-        if (it != subscribers.end())
             subscribers.erase(it);
+            handler = subscriptionsChangedHandler;
+        }
+
+        if (handler)
+            handler();
+    }
+
+    // The handler is called outside of the subscribers lock, so it may query the publisher
+    void setSubscriptionsChangedHandler(SubscriptionsChangedHandler handler)
+    {
+        std::scoped_lock lock(subscribersMt);
+        subscriptionsChangedHandler = std::move(handler);
+    }
+
+    std::vector<Topic> getTopics() const
+    {
+        std::scoped_lock lock(subscribersMt);
+
+        std::unordered_set<Topic, TopicHasher> topics;
+        for (const auto& [topic, subscriber] : subscribers)
+            topics.insert(topic);
+
+        return {topics.begin(), topics.end()};
     }
 
     void publish(const Topic& topic, const std::shared_ptr<ASAM::CMP::Packet>& packet)
@@ -81,6 +119,7 @@ public:
 private:
     mutable std::mutex subscribersMt;
     std::unordered_multimap<Topic, Subscriber*, TopicHasher> subscribers;
+    SubscriptionsChangedHandler subscriptionsChangedHandler;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
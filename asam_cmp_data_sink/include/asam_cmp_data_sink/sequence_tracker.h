@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include <coreobjects/property_object_ptr.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+struct SequenceStatistics
+{
+    uint64_t received{0};
+    uint64_t lost{0};
+    uint64_t duplicated{0};
+    uint64_t reordered{0};
+    double lossRate{0.0};
+};
+
+// Tracks the CMP header sequence counter of the data messages of every (deviceId, streamId) pair seen on the wire. The
+// counter belongs to the CMP message header, so all interfaces that share a stream id also share the counter and the
+// statistics are per CMP stream, not per interface. track() is called from the capture thread only, statistics can be
+// read from any thread.
+class SequenceTracker final
+{
+public:
+    using StreamKey = std::pair<uint16_t, uint8_t>;
+
+    SequenceTracker();
+    ~SequenceTracker();
+
+    SequenceTracker(const SequenceTracker&) = delete;
+    SequenceTracker& operator=(const SequenceTracker&) = delete;
+
+    // Messages other than data messages are ignored
+    void track(const uint8_t* data, size_t size);
+    void track(uint16_t deviceId, uint8_t streamId, uint16_t sequenceCounter);
+
+    // Once called, lost messages are only counted for the given (deviceId, streamId) pairs. The counter of a stream
+    // steps over the messages of interfaces dropped by the capture filter, so gaps of the other streams are no losses.
+    void setLossTrackedStreams(const std::set<StreamKey>& streams);
+
+    SequenceStatistics getStatistics(uint16_t deviceId, uint8_t streamId) const;
+    SequenceStatistics getStatistics(uint16_t deviceId) const;
+
+public:
+    static constexpr uint16_t maxReorderDistance = 64;
+    static constexpr uint64_t lossRateWindow = 1000;
+
+private:
+    struct StreamEntry
+    {
+        uint16_t lastSequenceCounter{0};
+        bool initialized{false};
+        uint64_t windowExpected{0};
+        uint64_t windowLost{0};
+
+        std::atomic_bool lossTracked{false};
+        // Set when lossTracked changes, the capture thread starts over from the next message
+        std::atomic_bool resync{false};
+
+        std::atomic<uint64_t> received{0};
+        std::atomic<uint64_t> lost{0};
+        std::atomic<uint64_t> duplicated{0};
+        std::atomic<uint64_t> reordered{0};
+        std::atomic<double> lossRate{0.0};
+    };
+
+    using DeviceEntry = std::array<StreamEntry, 256>;
+
+    static constexpr size_t devicesCount = 65536;
+
+    DeviceEntry& getDeviceEntry(uint16_t deviceId);
+    void trackLoss(StreamEntry& entry, uint16_t sequenceCounter);
+    static void setLossTracked(StreamEntry& entry, bool tracked);
+    static void updateLossRate(StreamEntry& entry, uint64_t expected, uint64_t lost);
+    static SequenceStatistics loadStatistics(const StreamEntry& entry);
+
+private:
+    std::unique_ptr<std::atomic<DeviceEntry*>[]> devices;
+    std::atomic_bool lossTrackingRestricted{false};
+
+    // Ids of the allocated devices, so setLossTrackedStreams doesn't walk all device slots
+    std::mutex allocatedDevicesSync;
+    std::vector<uint16_t> allocatedDevices;
+};
+
+// Adds read-only ReceivedMessages, LostMessages, DuplicatedMessages, ReorderedMessages and LossRate properties whose
+// values are taken from getStatistics on every read
+void addSequenceStatisticsProperties(PropertyObjectPtr obj, std::function<SequenceStatistics()> getStatistics);
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
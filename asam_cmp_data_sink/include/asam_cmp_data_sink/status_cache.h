@@ -0,0 +1,49 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp/packet.h>
+#include <asam_cmp/status.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Last known status of the capture modules seen on one network adapter. It is stored as the encoded CMP status
+// messages, so restoring it goes through the same path as status messages received from the wire.
+class StatusCache final
+{
+public:
+    StatusCache(const std::filesystem::path& directory, const std::string& adapterName);
+
+    const std::string& getAdapterName() const;
+    const std::filesystem::path& getFilePath() const;
+
+    // Returns no packets if nothing is cached yet, throws std::runtime_error if the file is corrupted
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> load() const;
+    // The file is replaced atomically, so a crash while saving leaves the previous status in place
+    void save(const ASAM::CMP::Status& status) const;
+
+private:
+    std::string adapterName;
+    std::filesystem::path filePath;
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
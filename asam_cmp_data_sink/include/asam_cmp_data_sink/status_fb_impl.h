@@ -17,6 +17,7 @@
 #pragma once
 #include <asam_cmp/status.h>
 #include <opendaq/function_block_impl.h>
+#include <mutex>
 
 #include <asam_cmp_data_sink/status_handler.h>
 #include <asam_cmp_data_sink/common.h>
@@ -38,10 +39,12 @@ public:
 private:
     void initProperties();
     void clear();
+    bool isStatusChanged(const ASAM::CMP::Packet& packet) const;
 
 private:
-    mutable std::mutex stMutex;
+    std::mutex stMutex;
     ASAM::CMP::Status status;
+    StatusStore statusStore;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
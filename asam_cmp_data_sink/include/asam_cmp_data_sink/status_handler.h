@@ -17,38 +17,79 @@
 #pragma once
 #include <asam_cmp/packet.h>
 #include <asam_cmp/status.h>
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <coretypes/baseobject.h>
 
 #include <asam_cmp_data_sink/common.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
+struct StatusSnapshot
+{
+    uint64_t version{0};
+    ASAM::CMP::Status status;
+};
+
+// Readers take immutable snapshots with an atomic load, so they never block the receive thread
+class StatusStore final
+{
+public:
+    using SnapshotPtr = std::shared_ptr<const StatusSnapshot>;
+
+    StatusStore()
+        : snapshot(std::make_shared<const StatusSnapshot>())
+    {
+    }
+
+    SnapshotPtr load() const
+    {
+        return std::atomic_load(&snapshot);
+    }
+
+    // Must be called by a single writer at a time
+    void publish(const ASAM::CMP::Status& status)
+    {
+        auto newSnapshot = std::make_shared<const StatusSnapshot>(StatusSnapshot{load()->version + 1, status});
+        std::atomic_store(&snapshot, SnapshotPtr(std::move(newSnapshot)));
+    }
+
+private:
+    SnapshotPtr snapshot;
+};
+
 class StatusMt final
 {
 public:
-    StatusMt(const ASAM::CMP::Status& st, std::mutex& mt)
-        : statusRef(st)
-        , mtRef(mt)
+    explicit StatusMt(const StatusStore& store)
+        : storeRef(store)
     {
     }
 
     ASAM::CMP::Status getStatus() const
     {
-        std::scoped_lock lock(mtRef);
-        return statusRef;
+        return storeRef.load()->status;
+    }
+
+    StatusStore::SnapshotPtr getSnapshot() const
+    {
+        return storeRef.load();
+    }
+
+    uint64_t getVersion() const
+    {
+        return storeRef.load()->version;
     }
 
     ASAM::CMP::DeviceStatus getDeviceStatus(size_t index) const
     {
-        std::scoped_lock lock(mtRef);
-        return index < statusRef.getDeviceStatusCount() ? statusRef.getDeviceStatus(index) : ASAM::CMP::DeviceStatus{};
+        const auto snapshot = storeRef.load();
+        const auto& status = snapshot->status;
+        return index < status.getDeviceStatusCount() ? status.getDeviceStatus(index) : ASAM::CMP::DeviceStatus{};
     }
 
 private:
-    std::mutex& mtRef;
-    const ASAM::CMP::Status& statusRef;
+    const StatusStore& storeRef;
 };
 
 DECLARE_OPENDAQ_INTERFACE(IStatusHandler, IBaseObject)
@@ -57,4 +98,17 @@ DECLARE_OPENDAQ_INTERFACE(IStatusHandler, IBaseObject)
     virtual StatusMt getStatusMt() const = 0;
 };
 
+DECLARE_OPENDAQ_INTERFACE(IStatusListener, IBaseObject)
+{
+    // Called after status packets have changed the status. Received status packets are processed on the capture thread, the
+    // Data Sink Module FB notifies from its own status change thread then, never from the capture thread.
+    virtual void statusChanged() = 0;
+};
+
+DECLARE_OPENDAQ_INTERFACE(IDeviceStatusSync, IBaseObject)
+{
+    // Brings the Interface and Stream FBs in line with the status of the device
+    virtual void syncWithStatus(const ASAM::CMP::DeviceStatus& newStatus) = 0;
+};
+
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
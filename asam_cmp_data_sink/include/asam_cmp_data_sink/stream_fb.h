@@ -19,11 +19,16 @@
 #include <asam_cmp/can_payload.h>
 #include <asam_cmp/packet.h>
 #include <opendaq/packet_factory.h>
+#include <atomic>
+#include <chrono>
 
 #include <asam_cmp_common_lib/stream_common_fb_impl.h>
 #include <asam_cmp_data_sink/asam_cmp_packets_subscriber.h>
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/flush_timer.h>
+#include <asam_cmp_data_sink/packet_buffer_pool.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
@@ -34,6 +39,13 @@ struct CANData
     uint8_t length;
     uint8_t data[64];
 };
+
+struct CANClassicData
+{
+    uint32_t arbId;
+    uint8_t length;
+    uint8_t data[8];
+};
 #pragma pack(pop)
 
 class StreamFb final : public asam_cmp_common_lib::StreamCommonFbImpl<IAsamCmpPacketsSubscriber>
@@ -49,9 +61,10 @@ public:
                       const StringPtr& localId,
                       const asam_cmp_common_lib::StreamCommonInit& init,
                       DataPacketsPublisher& publisher,
+                      SequenceTracker& sequenceTracker,
                       const uint16_t& deviceId,
                       const uint32_t& interfaceId);
-    ~StreamFb() override = default;
+    ~StreamFb() override;
 
 protected:
     // IStreamCommon
@@ -64,15 +77,33 @@ protected:
     void updateStreamIdInternal() override;
 
 private:
+    void initProperties();
+    void updatePayloadTypeProperties();
     void createSignals();
     void buildDataDescriptor();
-    void buildCanDescriptor();
+    void buildCanDescriptor(size_t dataLength);
     void buildAnalogDescriptor(const AnalogPayload& payload);
     void buildAsyncDomainDescriptor();
     void buildSyncDomainDescriptor(const float sampleInterval);
+    void batchAsyncData(const std::vector<std::shared_ptr<Packet>>& packets);
+    void flushCanBatch();
+    void flushExpired(FlushTimer::Clock::time_point now);
+    void setFlushDeadline(FlushTimer::Clock::duration delay);
     void processAsyncData(const std::vector<std::shared_ptr<Packet>>& packets);
-    void fillCanData(CANData* const data, const std::shared_ptr<Packet>& packet);
+    template <typename CanDataType>
+    void fillCanSamples(void* buffer, uint64_t* domainBuffer, const std::vector<std::shared_ptr<Packet>>& packets);
+    template <typename CanDataType>
+    void fillCanData(CanDataType* const data, const std::shared_ptr<Packet>& packet);
+    bool isCanPayload() const;
+    bool isCompactCanData() const;
     void processSyncData(const std::shared_ptr<Packet>& packet);
+    void coalesceSyncData(const std::shared_ptr<Packet>& packet);
+    void flushCoalescedData();
+    void sendSyncData(uint64_t timestamp, const void* data, size_t sampleCount);
+    DataPacketPtr createPooledPacket(const DataPacketPtr& domainPacket,
+                                     const DataDescriptorPtr& descriptor,
+                                     uint64_t sampleCount,
+                                     const NumberPtr& offset);
     bool domainChanged(const AnalogPayload& payload);
     bool dataChanged(const AnalogPayload& payload);
 
@@ -85,11 +116,32 @@ private:
     const uint16_t& deviceId;
     const uint32_t& interfaceId;
     DataPacketsPublisher& publisher;
+    SequenceTracker& sequenceTracker;
 
     SignalConfigPtr dataSignal;
     SignalConfigPtr domainSignal;
     bool updateDescriptors{false};
     AnalogPayload::Header analogHeader{};
+
+    std::mutex dataSync;
+    std::atomic_bool coalescingEnabled{false};
+    std::atomic<size_t> maxCoalescedSamples{4096};
+    std::atomic<std::chrono::milliseconds> maxCoalescingLatency{std::chrono::milliseconds(20)};
+    std::vector<uint8_t> coalescedData;
+    size_t coalescedSamples{0};
+    uint64_t coalescedTimestamp{0};
+    std::chrono::steady_clock::time_point coalescingStartTime;
+
+    std::atomic<size_t> canBatchSize{1};
+    std::atomic<std::chrono::milliseconds> canBatchMaxDelay{std::chrono::milliseconds(10)};
+    std::vector<std::shared_ptr<Packet>> canBatch;
+    bool compactCanData{false};
+
+    std::shared_ptr<PacketBufferPool> bufferPool;
+    DeleterPtr bufferDeleter;
+
+    std::shared_ptr<FlushTimer> flushTimer;
+    std::atomic<FlushTimer::Clock::rep> flushDeadline{0};
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
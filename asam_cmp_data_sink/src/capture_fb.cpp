@@ -1,4 +1,5 @@
 #include <asam_cmp/capture_module_payload.h>
+#include <map>
 
 #include <asam_cmp_data_sink/capture_fb.h>
 #include <asam_cmp_data_sink/interface_fb.h>
@@ -9,12 +10,17 @@ CaptureFb::CaptureFb(const ContextPtr& ctx,
                      const ComponentPtr& parent,
                      const StringPtr& localId,
                      DataPacketsPublisher& dataPacketsPublisher,
-                     CapturePacketsPublisher& capturePacketsPublisher)
+                     CapturePacketsPublisher& capturePacketsPublisher,
+                     SequenceTracker& sequenceTracker,
+                     LatencyProbeTracker& latencyProbeTracker)
     : CaptureCommonFbImpl(ctx, parent, localId)
     , dataPacketsPublisher(dataPacketsPublisher)
     , capturePacketsPublisher(capturePacketsPublisher)
+    , sequenceTracker(sequenceTracker)
+    , latencyProbeTracker(latencyProbeTracker)
 {
     initDeviceInfoProperties(true);
+    initStatisticsProperties();
 }
 
 CaptureFb::CaptureFb(const ContextPtr& ctx,
@@ -22,13 +28,18 @@ CaptureFb::CaptureFb(const ContextPtr& ctx,
                      const StringPtr& localId,
                      DataPacketsPublisher& dataPacketsPublisher,
                      CapturePacketsPublisher& capturePacketsPublisher,
+                     SequenceTracker& sequenceTracker,
+                     LatencyProbeTracker& latencyProbeTracker,
                      ASAM::CMP::DeviceStatus&& deviceStatus)
     : CaptureCommonFbImpl(ctx, parent, localId)
     , dataPacketsPublisher(dataPacketsPublisher)
     , capturePacketsPublisher(capturePacketsPublisher)
+    , sequenceTracker(sequenceTracker)
+    , latencyProbeTracker(latencyProbeTracker)
     , deviceStatus(std::move(deviceStatus))
 {
     initDeviceInfoProperties(true);
+    initStatisticsProperties();
     setProperties();
     createFbs();
 }
@@ -38,6 +49,45 @@ void CaptureFb::receive(const std::shared_ptr<ASAM::CMP::Packet>& packet)
     setDeviceInfoProperties(*packet);
 }
 
+void CaptureFb::syncWithStatus(const ASAM::CMP::DeviceStatus& newStatus)
+{
+    std::scoped_lock lock{sync};
+    // The pending update is applied as the user set it
+    if (isUpdating)
+        return;
+
+    deviceStatus = newStatus;
+    setDeviceInfoProperties(deviceStatus.getPacket());
+
+    std::map<uint32_t, size_t> statusIndices;
+    for (size_t i = 0; i < deviceStatus.getInterfaceStatusCount(); ++i)
+        statusIndices.emplace(deviceStatus.getInterfaceStatus(i).getInterfaceId(), i);
+
+    const auto interfaceFbs = functionBlocks.getItems();
+    for (size_t i = interfaceFbs.getCount(); i-- > 0;)
+    {
+        const FunctionBlockPtr interfaceFb = interfaceFbs.getItemAt(i);
+        const uint32_t interfaceId = interfaceFb.getPropertyValue("InterfaceId");
+        const auto it = statusIndices.find(interfaceId);
+        if (it == statusIndices.end())
+        {
+            removeInterfaceInternal(i);
+            continue;
+        }
+
+        // InterfaceCommonFb implements no interfaces besides IFunctionBlock, so the implementation is checked directly
+        if (const auto interfaceImpl = dynamic_cast<InterfaceFb*>(interfaceFb.getObject()))
+            interfaceImpl->syncWithStatus(deviceStatus.getInterfaceStatus(it->second));
+        statusIndices.erase(it);
+    }
+
+    for (const auto& [interfaceId, index] : statusIndices)
+    {
+        auto ifStatus = deviceStatus.getInterfaceStatus(index);
+        addInterfaceWithParams<InterfaceFb>(interfaceId, deviceId, dataPacketsPublisher, sequenceTracker, std::move(ifStatus));
+    }
+}
+
 void CaptureFb::updateDeviceIdInternal()
 {
     auto oldDeviceId = deviceId;
@@ -64,7 +114,7 @@ void CaptureFb::updateDeviceIdInternal()
 void CaptureFb::addInterfaceInternal()
 {
     auto interfaceId = interfaceIdManager.getFirstUnusedId();
-    addInterfaceWithParams<InterfaceFb>(interfaceId, deviceId, dataPacketsPublisher);
+    addInterfaceWithParams<InterfaceFb>(interfaceId, deviceId, dataPacketsPublisher, sequenceTracker);
 }
 
 void CaptureFb::removeInterfaceInternal(size_t nInd)
@@ -81,6 +131,12 @@ void CaptureFb::removeInterfaceInternal(size_t nInd)
     CaptureCommonFbImpl::removeInterfaceInternal(nInd);
 }
 
+void CaptureFb::initStatisticsProperties()
+{
+    addSequenceStatisticsProperties(objPtr, [this] { return sequenceTracker.getStatistics(deviceId); });
+    addLatencyProbeProperties(objPtr, [this] { return latencyProbeTracker.getStatistics(deviceId); });
+}
+
 void CaptureFb::setProperties()
 {
     objPtr.setPropertyValue("DeviceId", deviceStatus.getPacket().getDeviceId());
@@ -122,7 +178,7 @@ void CaptureFb::createFbs()
     {
         auto ifStatus = deviceStatus.getInterfaceStatus(i);
         auto interfaceId = ifStatus.getInterfaceId();
-        addInterfaceWithParams<InterfaceFb>(interfaceId, deviceId, dataPacketsPublisher, std::move(ifStatus));
+        addInterfaceWithParams<InterfaceFb>(interfaceId, deviceId, dataPacketsPublisher, sequenceTracker, std::move(ifStatus));
     }
 }
 
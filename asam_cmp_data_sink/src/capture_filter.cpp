@@ -0,0 +1,102 @@
+#include <asam_cmp/cmp_header.h>
+#include <asam_cmp/interface_payload.h>
+#include <asam_cmp_common_lib/latency_probe.h>
+#include <coretypes/common.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include <asam_cmp_data_sink/capture_filter.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    constexpr size_t ethHeaderSize = 14;
+    constexpr size_t deviceIdOffset = ethHeaderSize + 2;
+    constexpr size_t messageTypeOffset = ethHeaderSize + 4;
+    constexpr size_t streamIdOffset = ethHeaderSize + 5;
+    constexpr size_t cmpHeaderSize = 8;
+    constexpr size_t interfaceIdOffset = ethHeaderSize + cmpHeaderSize + 8;
+    constexpr size_t payloadLengthOffset = ethHeaderSize + cmpHeaderSize + 14;
+    constexpr size_t dataMessageHeaderSize = 16;
+
+    // If there is room for one more message header after the first payload, the frame may be aggregated
+    // and the interface id of the first message header is not representative for the whole frame
+    const std::string aggregatedFrameCondition =
+        fmt::format("ether[{}:2] + {} <= len", payloadLengthOffset, ethHeaderSize + cmpHeaderSize + 2 * dataMessageHeaderSize);
+}
+
+std::string createCaptureFilter(const std::vector<Endpoint>& endpoints)
+{
+    std::string filter = fmt::format("ether[{}] == {} or ether[{}] == {}",
+                                     messageTypeOffset,
+                                     to_underlying(ASAM::CMP::CmpHeader::MessageType::status),
+                                     messageTypeOffset,
+                                     asam_cmp_common_lib::latencyProbeMessageType);
+
+    std::map<std::pair<uint16_t, uint8_t>, std::vector<uint32_t>> interfacesByStream;
+    for (const auto& endpoint : endpoints)
+        interfacesByStream[{endpoint.deviceId, endpoint.streamId}].push_back(endpoint.interfaceId);
+
+    for (auto& [stream, interfaceIds] : interfacesByStream)
+    {
+        std::sort(interfaceIds.begin(), interfaceIds.end());
+
+        std::string interfacesCondition = aggregatedFrameCondition;
+        for (const auto interfaceId : interfaceIds)
+            interfacesCondition += fmt::format(" or ether[{}:4] == {}", interfaceIdOffset, interfaceId);
+
+        filter += fmt::format(" or (ether[{}] == {} and ether[{}:2] == {} and ether[{}] == {} and ({}))",
+                              messageTypeOffset,
+                              to_underlying(ASAM::CMP::CmpHeader::MessageType::data),
+                              deviceIdOffset,
+                              stream.first,
+                              streamIdOffset,
+                              stream.second,
+                              interfacesCondition);
+    }
+
+    return filter;
+}
+
+std::set<std::pair<uint16_t, uint8_t>> getFullyCapturedStreams(const std::vector<Endpoint>& endpoints, const ASAM::CMP::Status& status)
+{
+    std::map<std::pair<uint16_t, uint8_t>, std::set<uint32_t>> capturedInterfaces;
+    for (const auto& endpoint : endpoints)
+        capturedInterfaces[{endpoint.deviceId, endpoint.streamId}].insert(endpoint.interfaceId);
+
+    std::map<std::pair<uint16_t, uint8_t>, bool> streams;
+    for (size_t i = 0; i < status.getDeviceStatusCount(); ++i)
+    {
+        const auto& deviceStatus = status.getDeviceStatus(i);
+        const auto deviceId = deviceStatus.getPacket().getDeviceId();
+        for (size_t j = 0; j < deviceStatus.getInterfaceStatusCount(); ++j)
+        {
+            const auto& interfaceStatus = deviceStatus.getInterfaceStatus(j);
+            const auto& ifPayload = static_cast<const ASAM::CMP::InterfacePayload&>(interfaceStatus.getPacket().getPayload());
+            const auto streamIds = ifPayload.getStreamIds();
+            for (uint16_t k = 0; k < ifPayload.getStreamIdsCount(); ++k)
+            {
+                const std::pair<uint16_t, uint8_t> stream{deviceId, streamIds[k]};
+                const auto it = capturedInterfaces.find(stream);
+                const bool captured = it != capturedInterfaces.end() && it->second.count(interfaceStatus.getInterfaceId()) != 0;
+                const auto [streamIt, inserted] = streams.emplace(stream, captured);
+                if (!inserted)
+                    streamIt->second = streamIt->second && captured;
+            }
+        }
+    }
+
+    std::set<std::pair<uint16_t, uint8_t>> fullyCapturedStreams;
+    for (const auto& [stream, captured] : streams)
+    {
+        if (captured)
+            fullyCapturedStreams.insert(stream);
+    }
+
+    return fullyCapturedStreams;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
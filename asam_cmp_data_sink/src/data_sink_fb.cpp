@@ -11,11 +11,15 @@ DataSinkFb::DataSinkFb(const ContextPtr& ctx,
                        const StringPtr& localId,
                        StatusMt statusMt,
                        DataPacketsPublisher& dataPacketsPublisher,
-                       CapturePacketsPublisher& capturePacketsPublisher)
-    : FunctionBlock(CreateType(), ctx, parent, localId)
+                       CapturePacketsPublisher& capturePacketsPublisher,
+                       SequenceTracker& sequenceTracker,
+                       LatencyProbeTracker& latencyProbeTracker)
+    : FunctionBlockImpl(CreateType(), ctx, parent, localId)
     , status(statusMt)
     , dataPacketsPublisher(dataPacketsPublisher)
     , capturePacketsPublisher(capturePacketsPublisher)
+    , sequenceTracker(sequenceTracker)
+    , latencyProbeTracker(latencyProbeTracker)
 {
     initProperties();
 }
@@ -25,26 +29,63 @@ FunctionBlockTypePtr DataSinkFb::CreateType()
     return FunctionBlockType("asam_cmp_data_sink", "AsamCmpDataSink", "ASAM CMP Data Sink");
 }
 
-void DataSinkFb::addCaptureModuleFromStatus(int index)
+void DataSinkFb::statusChanged()
+{
+    if (autoSync)
+        syncWithStatus();
+}
+
+// Capture FBs are matched to the status by device ID and only their changed interfaces and streams are replaced, so the
+// signals of unchanged streams stay connected. Capture FBs of devices missing in the status are left as they are.
+void DataSinkFb::syncWithStatus()
 {
     std::scoped_lock lock{sync};
 
-    auto deviceStatus = status.getDeviceStatus(index);
+    const auto snapshot = status.getSnapshot();
+    const auto captureFbs = functionBlocks.getItems();
+    for (size_t i = 0; i < snapshot->status.getDeviceStatusCount(); ++i)
+    {
+        const auto& deviceStatus = snapshot->status.getDeviceStatus(i);
+        const Int deviceId = deviceStatus.getPacket().getDeviceId();
+
+        bool found = false;
+        for (const FunctionBlockPtr& captureFb : captureFbs)
+        {
+            if (static_cast<Int>(captureFb.getPropertyValue("DeviceId")) != deviceId)
+                continue;
+
+            captureFb.asPtr<IDeviceStatusSync>(true)->syncWithStatus(deviceStatus);
+            found = true;
+        }
+
+        if (!found)
+            addCaptureModule(ASAM::CMP::DeviceStatus(deviceStatus));
+    }
+}
+
+void DataSinkFb::addCaptureModule(ASAM::CMP::DeviceStatus&& deviceStatus)
+{
     const StringPtr fbId = getFbId(captureModuleId);
     const auto newFb = createWithImplementation<IFunctionBlock, CaptureFb>(
-        context, functionBlocks, fbId, dataPacketsPublisher, capturePacketsPublisher, std::move(deviceStatus));
+        context, functionBlocks, fbId, dataPacketsPublisher, capturePacketsPublisher, sequenceTracker, latencyProbeTracker, std::move(deviceStatus));
     functionBlocks.addItem(newFb);
     capturePacketsPublisher.subscribe(newFb.getPropertyValue("DeviceId"), newFb.as<IAsamCmpPacketsSubscriber>(true));
     ++captureModuleId;
 }
 
+void DataSinkFb::addCaptureModuleFromStatus(int index)
+{
+    std::scoped_lock lock{sync};
+    addCaptureModule(status.getDeviceStatus(index));
+}
+
 void DataSinkFb::addCaptureModuleEmpty()
 {
     std::scoped_lock lock{sync};
 
     const StringPtr fbId = getFbId(captureModuleId);
-    const auto newFb =
-        createWithImplementation<IFunctionBlock, CaptureFb>(context, functionBlocks, fbId, dataPacketsPublisher, capturePacketsPublisher);
+    const auto newFb = createWithImplementation<IFunctionBlock, CaptureFb>(
+        context, functionBlocks, fbId, dataPacketsPublisher, capturePacketsPublisher, sequenceTracker, latencyProbeTracker);
     functionBlocks.addItem(newFb);
     capturePacketsPublisher.subscribe(newFb.getPropertyValue("DeviceId"), newFb.as<IAsamCmpPacketsSubscriber>(true));
     ++captureModuleId;
@@ -84,6 +125,15 @@ void DataSinkFb::initProperties()
     auto proc = Procedure([this](IntPtr nItem) { addCaptureModuleFromStatus(nItem); });
     objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, proc);
 
+    propName = "AutoSync";
+    objPtr.addProperty(BoolProperty(propName, False));
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        autoSync = static_cast<bool>(args.getValue());
+        if (autoSync)
+            syncWithStatus();
+    };
+
     propName = "AddCaptureModuleEmpty";
     objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
     proc = Procedure([this]() { addCaptureModuleEmpty(); });
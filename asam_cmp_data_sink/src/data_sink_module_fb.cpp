@@ -2,24 +2,56 @@
 #include <asam_cmp/cmp_header.h>
 #include <coreobjects/callable_info_factory.h>
 
+#include <asam_cmp_data_sink/capture_filter.h>
 #include <asam_cmp_data_sink/data_sink_fb.h>
 #include <asam_cmp_data_sink/data_sink_module_fb.h>
 #include <asam_cmp_data_sink/status_fb_impl.h>
 
 #include <SystemUtils.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
+#include <asam_cmp_common_lib/latency_probe.h>
 
 #include <iostream>
+#include <limits>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
+namespace
+{
+    // Both the pcap timestamp and the system clock are wall-clock time
+    [[maybe_unused]] uint64_t getKernelRxLatency(const pcpp::RawPacket* packet)
+    {
+        const auto rxTime = packet->getPacketTimeStamp();
+        const auto rxTimeNs = static_cast<int64_t>(rxTime.tv_sec) * 1'000'000'000 + rxTime.tv_nsec;
+        const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        return nowNs > rxTimeNs ? static_cast<uint64_t>(nowNs - rxTimeNs) : 0;
+    }
+}
+
 DataSinkModuleFb::DataSinkModuleFb(const ContextPtr& ctx,
                                    const ComponentPtr& parent,
                                    const StringPtr& localId,
                                    const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper)
     : asam_cmp_common_lib::NetworkManagerFb(CreateType(), ctx, parent, localId, ethernetWrapper)
 {
+    initCaptureConfigurationProperties();
+    initStatisticsProperties();
+    initStatusCacheProperties();
+#ifdef ASAM_CMP_ENABLE_LATENCY_HISTOGRAMS
+    using asam_cmp_common_lib::LatencyStage;
+    asam_cmp_common_lib::addLatencyProperties(
+        objPtr, {LatencyStage::kernelRx, LatencyStage::decode, LatencyStage::publish, LatencyStage::packetCreation});
+#endif
+#ifdef ASAM_CMP_ENABLE_TRACING
+    asam_cmp_common_lib::addTraceProperties(objPtr);
+#endif
+    updateCaptureFilter();
+    dataPacketsPublisher.setSubscriptionsChangedHandler([this] { updateCaptureFilter(); });
+
     createFbs();
+    statusChangeThread = std::thread(&DataSinkModuleFb::statusChangeLoop, this);
     startCapture();
 }
 
@@ -32,17 +64,27 @@ FunctionBlockPtr DataSinkModuleFb::create(const ContextPtr& ctx, const Component
 
 DataSinkModuleFb::~DataSinkModuleFb()
 {
+    dataPacketsPublisher.setSubscriptionsChangedHandler(nullptr);
     stopCapture();
+    stopStatusChangeThread();
 }
 
 ErrCode INTERFACE_FUNC DataSinkModuleFb::remove()
 {
+    dataPacketsPublisher.setSubscriptionsChangedHandler(nullptr);
     stopCapture();
+    stopStatusChangeThread();
     return Super::remove();
 }
 
 void DataSinkModuleFb::networkAdapterChangedInternal()
 {
+    {
+        std::scoped_lock lock{statusCacheSync};
+        const auto cache = std::atomic_load(&statusCache);
+        if (cache && cache->getAdapterName() != selectedEthernetDeviceName.toStdString())
+            updateStatusCache();
+    }
     startCapture();
 }
 
@@ -51,17 +93,208 @@ FunctionBlockTypePtr DataSinkModuleFb::CreateType()
     return FunctionBlockType("asam_cmp_data_sink_module", "AsamCmpDataSinkModule", "ASAM CMP Data Sink Module");
 }
 
+void DataSinkModuleFb::initCaptureConfigurationProperties()
+{
+    addCaptureConfigurationProperty("CaptureBufferSize", &asam_cmp_common_lib::CaptureConfiguration::bufferSize, std::numeric_limits<int>::max());
+    addCaptureConfigurationProperty("SnapshotLength", &asam_cmp_common_lib::CaptureConfiguration::snapshotLength, 262144);
+    addCaptureConfigurationProperty("ReadTimeout", &asam_cmp_common_lib::CaptureConfiguration::readTimeout, 10000);
+
+    StringPtr propName = "ImmediateMode";
+    objPtr.addProperty(BoolProperty(propName, captureConfiguration.immediateMode));
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        captureConfiguration.immediateMode = args.getValue();
+        applyCaptureConfiguration();
+    };
+
+    propName = "SuppressLocalFrames";
+    objPtr.addProperty(BoolProperty(propName, captureConfiguration.suppressLocalFrames));
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        captureConfiguration.suppressLocalFrames = args.getValue();
+        applyCaptureConfiguration();
+    };
+
+    propName = "CaptureMode";
+    ListPtr<StringPtr> captureModes{"PerPacket", "Batch"};
+    objPtr.addProperty(SelectionPropertyBuilder(propName, captureModes, 0).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        captureMode = static_cast<Int>(args.getValue()) == 0 ? asam_cmp_common_lib::CaptureMode::perPacket
+                                                              : asam_cmp_common_lib::CaptureMode::batch;
+        startCapture();
+    };
+
+    propName = "BatchSize";
+    objPtr.addProperty(IntPropertyBuilder(propName, captureConfiguration.batchSize).setMinValue(1).setMaxValue(65536).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        captureConfiguration.batchSize = static_cast<Int>(args.getValue());
+        applyCaptureConfiguration();
+    };
+}
+
+void DataSinkModuleFb::addCaptureConfigurationProperty(const StringPtr& propName, int asam_cmp_common_lib::CaptureConfiguration::*field, Int maxValue)
+{
+    objPtr.addProperty(IntPropertyBuilder(propName, captureConfiguration.*field).setMinValue(0).setMaxValue(maxValue).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this, field](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        captureConfiguration.*field = static_cast<int>(static_cast<Int>(args.getValue()));
+        applyCaptureConfiguration();
+    };
+}
+
+void DataSinkModuleFb::applyCaptureConfiguration()
+{
+    if (!ethernetWrapper->setCaptureConfiguration(captureConfiguration))
+        LOG_W("Network adapter is captured by other Data Sink Module FBs, its buffer size, snapshot length and read timeout are kept");
+    startCapture();
+}
+
+void DataSinkModuleFb::initStatisticsProperties()
+{
+    // libpcap counters are cumulative since the adapter was opened, so they are polled on every read
+    const auto addCounter = [this](const StringPtr& propName, uint64_t asam_cmp_common_lib::CaptureStatistics::*counter)
+    {
+        objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+        objPtr.getOnPropertyValueRead(propName) += [this, counter](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+        { args.setValue(Integer(static_cast<Int>(ethernetWrapper->getCaptureStatistics().*counter))); };
+    };
+
+    addCounter("ReceivedFrames", &asam_cmp_common_lib::CaptureStatistics::received);
+    addCounter("DroppedByKernel", &asam_cmp_common_lib::CaptureStatistics::droppedByKernel);
+    addCounter("DroppedByInterface", &asam_cmp_common_lib::CaptureStatistics::droppedByInterface);
+}
+
+void DataSinkModuleFb::initStatusCacheProperties()
+{
+    StringPtr propName = "StatusCache";
+    objPtr.addProperty(BoolProperty(propName, statusCacheEnabled));
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        std::scoped_lock lock{statusCacheSync};
+        statusCacheEnabled = args.getValue();
+        updateStatusCache();
+    };
+
+    propName = "StatusCacheDirectory";
+    objPtr.addProperty(StringPropertyBuilder(propName, statusCacheDirectory).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        StringPtr directory = args.getValue();
+        std::scoped_lock lock{statusCacheSync};
+        statusCacheDirectory = directory.toStdString();
+        updateStatusCache();
+    };
+}
+
+// Must be called under statusCacheSync
+void DataSinkModuleFb::updateStatusCache()
+{
+    std::shared_ptr<const StatusCache> cache;
+    if (statusCacheEnabled)
+        cache = std::make_shared<const StatusCache>(statusCacheDirectory, selectedEthernetDeviceName.toStdString());
+
+    std::atomic_store(&statusCache, cache);
+    if (cache)
+        restoreStatus(*cache);
+}
+
+void DataSinkModuleFb::restoreStatus(const StatusCache& cache)
+{
+    // The cached packets take the same path as received ones, so they are merged into the status the same way
+    try
+    {
+        for (const auto& packet : cache.load())
+            statusHandler->processStatusPacket(packet);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Cached status can't be restored: {}", e.what());
+    }
+    processStatusChange();
+}
+
+void DataSinkModuleFb::processStatusChange()
+{
+    std::scoped_lock lock{statusChangeSync};
+
+    // The status version only changes with the topology, so periodic status messages end here
+    const auto snapshot = statusHandler->getStatusMt().getSnapshot();
+    if (snapshot->version == processedStatusVersion)
+        return;
+    processedStatusVersion = snapshot->version;
+
+    if (const auto cache = std::atomic_load(&statusCache))
+    {
+        try
+        {
+            cache->save(snapshot->status);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_W("Status can't be cached: {}", e.what());
+        }
+    }
+
+    {
+        std::scoped_lock filterLock{captureFilterSync};
+        updateLossTracking(dataPacketsPublisher.getTopics());
+    }
+
+    statusListener->statusChanged();
+}
+
+void DataSinkModuleFb::requestStatusChange()
+{
+    {
+        std::scoped_lock lock{statusChangeRequestSync};
+        statusChangePending = true;
+    }
+    statusChangeRequested.notify_one();
+}
+
+void DataSinkModuleFb::statusChangeLoop()
+{
+    std::unique_lock lock{statusChangeRequestSync};
+    while (true)
+    {
+        statusChangeRequested.wait(lock, [this] { return statusChangePending || stopStatusChanges; });
+        if (stopStatusChanges)
+            return;
+
+        // Requests coming in meanwhile are handled by one more pass, which picks up the latest status
+        statusChangePending = false;
+        lock.unlock();
+        processStatusChange();
+        lock.lock();
+    }
+}
+
+void DataSinkModuleFb::stopStatusChangeThread()
+{
+    {
+        std::scoped_lock lock{statusChangeRequestSync};
+        stopStatusChanges = true;
+    }
+    statusChangeRequested.notify_one();
+    if (statusChangeThread.joinable())
+        statusChangeThread.join();
+}
+
 void DataSinkModuleFb::createFbs()
 {
     const StringPtr statusId = "asam_cmp_status";
     auto newFb = createWithImplementation<IFunctionBlock, StatusFbImpl>(context, functionBlocks, statusId);
     functionBlocks.addItem(newFb);
-    auto statusMt = functionBlocks.getItems()[0].asPtr<IStatusHandler>(true)->getStatusMt();
+    statusHandler = newFb.asPtr<IStatusHandler>(true);
+    auto statusMt = statusHandler->getStatusMt();
 
     const StringPtr dataSinkId = "asam_cmp_data_sink";
     newFb = createWithImplementation<IFunctionBlock, DataSinkFb>(
-        context, functionBlocks, dataSinkId, statusMt, dataPacketsPublisher, capturePacketsPublisher);
+        context, functionBlocks, dataSinkId, statusMt, dataPacketsPublisher, capturePacketsPublisher, sequenceTracker, latencyProbeTracker);
     functionBlocks.addItem(newFb);
+    statusListener = newFb.asPtr<IStatusListener>(true);
 }
 
 void DataSinkModuleFb::startCapture()
@@ -69,9 +302,25 @@ void DataSinkModuleFb::startCapture()
     std::scoped_lock lock{sync};
 
     stopCapture();
-    ethernetWrapper->startCapture([this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
-                                  { onPacketArrives(packet, dev, cookie); });
+    try
+    {
+        if (captureMode == asam_cmp_common_lib::CaptureMode::batch)
+        {
+            ethernetWrapper->startBatchCapture([this](const std::vector<pcpp::RawPacket*>& packets) { onPacketsArrive(packets); });
+        }
+        else
+        {
+            ethernetWrapper->startCapture([this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
+                                          { onPacketArrives(packet, dev, cookie); });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Capture can't be started: {}", e.what());
+        return;
+    }
     captureStartedOnThisFb = true;
+    updateSelectedAdapterName();
 }
 
 void DataSinkModuleFb::stopCapture()
@@ -83,12 +332,47 @@ void DataSinkModuleFb::stopCapture()
     }
 }
 
+void DataSinkModuleFb::updateCaptureFilter()
+{
+    std::scoped_lock lock{captureFilterSync};
+
+    const auto endpoints = dataPacketsPublisher.getTopics();
+    updateLossTracking(endpoints);
+
+    auto newFilter = createCaptureFilter(endpoints);
+    if (newFilter == captureFilter)
+        return;
+
+    captureFilter = std::move(newFilter);
+    if (!ethernetWrapper->setCaptureFilter(captureFilter))
+        LOG_W("Capture filter can't be applied, all ASAM CMP messages are captured: {}", captureFilter);
+}
+
+// Must be called under captureFilterSync
+void DataSinkModuleFb::updateLossTracking(const std::vector<Endpoint>& endpoints)
+{
+    // Until the status is known, it is unknown which interfaces share a stream
+    if (!statusHandler.assigned())
+    {
+        sequenceTracker.setLossTrackedStreams({});
+        return;
+    }
+
+    sequenceTracker.setLossTrackedStreams(getFullyCapturedStreams(endpoints, statusHandler->getStatusMt().getSnapshot()->status));
+}
+
 void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
 {
+    ASAM_CMP_LATENCY_RECORD(kernelRx, getKernelRxLatency(packet));
+    ASAM_CMP_TRACE_SCOPE("SinkPacketArrives");
+
     auto acPackets = decode(packet);
     if (acPackets.empty())
         return;
 
+    ASAM_CMP_LATENCY_SCOPE(publish);
+    ASAM_CMP_TRACE_SCOPE("SinkPublish");
+
     // "Aggregation of multiple CMP Messages can be realized for different DATA_MESSAGE_PAYLOAD_TYPEs"
     // We can process multiple packets simultaneously only if they are of the same type and IDs
 
@@ -110,6 +394,7 @@ void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDe
     }
     else
     {
+        bool statusReceived = false;
         for (const auto& acPacket : acPackets)
         {
             switch (acPacket->getMessageType())
@@ -118,7 +403,8 @@ void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDe
                     dataPacketsPublisher.publish({deviceId, interfaceId, streamId}, acPacket);
                     break;
                 case ASAM::CMP::CmpHeader::MessageType::status:
-                    functionBlocks.getItems()[0].asPtr<IStatusHandler>(true)->processStatusPacket(acPacket);
+                    statusHandler->processStatusPacket(acPacket);
+                    statusReceived = true;
                     if (payloadType == ASAM::CMP::PayloadType::cmStatMsg)
                         capturePacketsPublisher.publish(deviceId, acPacket);
                     break;
@@ -126,16 +412,46 @@ void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDe
                     LOG_I("ASAM CMP Message Type {} is not supported", to_underlying(acPacket->getMessageType()));
             }
         }
+        if (statusReceived)
+            requestStatusChange();
     }
 }
 
+void DataSinkModuleFb::onPacketsArrive(const std::vector<pcpp::RawPacket*>& packets)
+{
+    ASAM_CMP_TRACE_COUNTER("SinkBatchSize", packets.size());
+    for (const auto packet : packets)
+        onPacketArrives(packet, nullptr, nullptr);
+}
+
 std::vector<std::shared_ptr<ASAM::CMP::Packet>> DataSinkModuleFb::decode(pcpp::RawPacket* packet)
 {
+    ASAM_CMP_LATENCY_SCOPE(decode);
+    ASAM_CMP_TRACE_SCOPE("SinkDecode");
+
     pcpp::Packet parsedPacket(packet);
     pcpp::EthLayer* ethLayer = static_cast<pcpp::EthLayer*>(parsedPacket.getLayerOfType(pcpp::Ethernet));
     assert(pcpp::netToHost16(ethLayer->getEthHeader()->etherType) == asam_cmp_common_lib::EthernetPcppImpl::asamCmpEtherType);
 
+    if (processLatencyProbe(packet, ethLayer->getLayerPayload(), ethLayer->getLayerPayloadSize()))
+        return {};
+
+    sequenceTracker.track(ethLayer->getLayerPayload(), ethLayer->getLayerPayloadSize());
     return decoder.decode(ethLayer->getLayerPayload(), ethLayer->getLayerPayloadSize());
 }
 
+bool DataSinkModuleFb::processLatencyProbe(const pcpp::RawPacket* packet, const uint8_t* data, size_t size)
+{
+    asam_cmp_common_lib::LatencyProbe probe;
+    if (!asam_cmp_common_lib::decodeLatencyProbe(data, size, probe))
+        return false;
+
+    const auto rxTime = packet->getPacketTimeStamp();
+    const auto rxTimeNs = static_cast<int64_t>(rxTime.tv_sec) * 1'000'000'000 + rxTime.tv_nsec;
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    const auto txTimeNs = static_cast<int64_t>(probe.txTime);
+    latencyProbeTracker.record(probe.deviceId, rxTimeNs - txTimeNs, nowNs - txTimeNs);
+    return true;
+}
+
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
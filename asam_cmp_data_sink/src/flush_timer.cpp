@@ -0,0 +1,129 @@
+#include <asam_cmp_data_sink/flush_timer.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+std::shared_ptr<FlushTimer> FlushTimer::getInstance()
+{
+    static std::mutex instanceSync;
+    static std::weak_ptr<FlushTimer> instance;
+
+    std::scoped_lock lock(instanceSync);
+    auto timer = instance.lock();
+    if (!timer)
+    {
+        timer = std::make_shared<FlushTimer>();
+        instance = timer;
+    }
+
+    return timer;
+}
+
+FlushTimer::FlushTimer()
+    : timerThread(&FlushTimer::timerLoop, this)
+{
+}
+
+FlushTimer::~FlushTimer()
+{
+    {
+        std::scoped_lock lock(sync);
+        stopTimer = true;
+    }
+    cv.notify_all();
+    timerThread.join();
+}
+
+void FlushTimer::schedule(const void* owner, Clock::time_point deadline, FlushCallback callback)
+{
+    bool earliest;
+    {
+        std::scoped_lock lock(sync);
+        auto it = std::find_if(entries.begin(), entries.end(), [owner](const Entry& entry) { return entry.owner == owner; });
+        if (it == entries.end())
+            it = entries.insert(entries.end(), Entry{owner, deadline, std::move(callback)});
+        else
+            *it = Entry{owner, deadline, std::move(callback)};
+
+        earliest = std::none_of(entries.begin(), entries.end(), [deadline](const Entry& entry) { return entry.deadline < deadline; });
+    }
+
+    if (earliest)
+        cv.notify_all();
+}
+
+void FlushTimer::cancel(const void* owner)
+{
+    {
+        std::scoped_lock lock(sync);
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [owner](const Entry& entry) { return entry.owner == owner; }),
+                      entries.end());
+    }
+
+    if (std::this_thread::get_id() == timerThread.get_id())
+    {
+        for (auto& entry : dueEntries)
+        {
+            if (entry.owner == owner)
+                entry.owner = nullptr;
+        }
+        return;
+    }
+
+    // Wait for the due callbacks that may still be using the owner
+    std::scoped_lock callbackLock(callbackSync);
+}
+
+void FlushTimer::timerLoop()
+{
+    std::unique_lock lock(sync);
+    while (!stopTimer)
+    {
+        if (entries.empty())
+        {
+            cv.wait(lock, [this] { return stopTimer || !entries.empty(); });
+            continue;
+        }
+
+        const auto next =
+            std::min_element(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.deadline < rhs.deadline; })
+                ->deadline;
+        auto now = Clock::now();
+        if (now < next)
+        {
+            // An earlier deadline or a stop request wakes the thread up, the schedule is checked again
+            cv.wait_until(lock, next);
+            continue;
+        }
+
+        for (size_t i = 0; i < entries.size();)
+        {
+            if (entries[i].deadline <= now)
+            {
+                dueEntries.push_back(std::move(entries[i]));
+                if (i + 1 != entries.size())
+                    entries[i] = std::move(entries.back());
+                entries.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        lock.unlock();
+        {
+            std::scoped_lock callbackLock(callbackSync);
+            now = Clock::now();
+            for (const auto& entry : dueEntries)
+            {
+                if (entry.owner != nullptr)
+                    entry.callback(now);
+            }
+            dueEntries.clear();
+        }
+        lock.lock();
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
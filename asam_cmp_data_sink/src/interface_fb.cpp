@@ -1,4 +1,5 @@
 #include <asam_cmp/interface_payload.h>
+#include <set>
 
 #include <asam_cmp_data_sink/interface_fb.h>
 #include <asam_cmp_data_sink/stream_fb.h>
@@ -10,10 +11,12 @@ InterfaceFb::InterfaceFb(const ContextPtr& ctx,
                          const StringPtr& localId,
                          const asam_cmp_common_lib::InterfaceCommonInit& init,
                          const uint16_t& deviceId,
-                         DataPacketsPublisher& publisher)
+                         DataPacketsPublisher& publisher,
+                         SequenceTracker& sequenceTracker)
     : InterfaceCommonFb(ctx, parent, localId, init)
     , deviceId(deviceId)
     , publisher(publisher)
+    , sequenceTracker(sequenceTracker)
 {
 }
 
@@ -23,11 +26,13 @@ InterfaceFb::InterfaceFb(const ContextPtr& ctx,
                          const asam_cmp_common_lib::InterfaceCommonInit& init,
                          const uint16_t& deviceId,
                          DataPacketsPublisher& publisher,
+                         SequenceTracker& sequenceTracker,
                          ASAM::CMP::InterfaceStatus&& ifStatus)
     : InterfaceCommonFb(ctx, parent, localId, init)
     , interfaceStatus(std::move(ifStatus))
     , deviceId(deviceId)
     , publisher(publisher)
+    , sequenceTracker(sequenceTracker)
 {
     createFbs();
 }
@@ -48,10 +53,53 @@ void InterfaceFb::updateInterfaceIdInternal()
     }
 }
 
+void InterfaceFb::syncWithStatus(const ASAM::CMP::InterfaceStatus& newStatus)
+{
+    std::scoped_lock lock{sync};
+    // The pending update is applied as the user set it
+    if (isUpdating)
+        return;
+
+    interfaceStatus = newStatus;
+    const auto& ifPayload = static_cast<const ASAM::CMP::InterfacePayload&>(interfaceStatus.getPacket().getPayload());
+
+    ASAM::CMP::PayloadType newPayloadType(0);
+    newPayloadType.setMessageType(ASAM::CMP::CmpHeader::MessageType::data);
+    newPayloadType.setRawPayloadType(ifPayload.getInterfaceType());
+    const auto payloadTypeIt = asamPayloadTypeToPayloadType.find(newPayloadType.getType());
+    if (newPayloadType.isValid() && newPayloadType.getType() != payloadType.getType() && payloadTypeIt != asamPayloadTypeToPayloadType.end())
+    {
+        // Existing streams switch their signal descriptors in place
+        setPropertyValueInternal(
+            String("PayloadType").asPtr<IString>(true), BaseObjectPtr(payloadTypeIt->second).asPtr<IBaseObject>(true), false, false, false);
+        updatePayloadTypeInternal();
+    }
+
+    std::set<uint8_t> newStreamIds;
+    const auto streamIds = ifPayload.getStreamIds();
+    for (uint16_t i = 0; i < ifPayload.getStreamIdsCount(); ++i)
+        newStreamIds.insert(streamIds[i]);
+
+    const auto streamFbs = functionBlocks.getItems();
+    for (size_t i = streamFbs.getCount(); i-- > 0;)
+    {
+        const uint8_t streamId = static_cast<Int>(streamFbs.getItemAt(i).getPropertyValue("StreamId"));
+        if (newStreamIds.erase(streamId) == 0)
+            removeStreamInternal(i);
+    }
+
+    for (const auto streamId : newStreamIds)
+        addStreamWithId(streamId);
+}
+
 void InterfaceFb::addStreamInternal()
 {
-    auto streamId = streamIdManager.getFirstUnusedId();
-    auto newFb = addStreamWithParams<StreamFb>(streamId, publisher, deviceId, interfaceId);
+    addStreamWithId(streamIdManager.getFirstUnusedId());
+}
+
+void InterfaceFb::addStreamWithId(uint8_t streamId)
+{
+    auto newFb = addStreamWithParams<StreamFb>(streamId, publisher, sequenceTracker, deviceId, interfaceId);
     publisher.subscribe({deviceId, interfaceId, streamId}, newFb.as<IAsamCmpPacketsSubscriber>(true));
 }
 
@@ -72,11 +120,7 @@ void InterfaceFb::createFbs()
         objPtr.setPropertyValue("PayloadType", asamPayloadTypeToPayloadType.at(payloadType.getType()));
     auto streamIds = ifPayload.getStreamIds();
     for (uint16_t i = 0; i < ifPayload.getStreamIdsCount(); ++i)
-    {
-        auto newId = streamIds[i];
-        auto newFb = addStreamWithParams<StreamFb>(newId, publisher, deviceId, interfaceId);
-        publisher.subscribe({deviceId, interfaceId, newId}, newFb.as<IAsamCmpPacketsSubscriber>(true));
-    }
+        addStreamWithId(streamIds[i]);
 }
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,73 @@
+#include <coreobjects/property_factory.h>
+#include <coreobjects/property_object_factory.h>
+#include <algorithm>
+#include <vector>
+
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    int64_t getPercentile(std::vector<int64_t>& values, double percentile)
+    {
+        const auto index = std::min(values.size() - 1, static_cast<size_t>(percentile / 100.0 * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+void LatencyProbeTracker::record(uint16_t deviceId, int64_t transportLatency, int64_t processingLatency)
+{
+    std::scoped_lock lock(sync);
+    auto& entry = devices[deviceId];
+    const auto ind = entry.received % windowSize;
+    entry.transport[ind] = transportLatency;
+    entry.processing[ind] = processingLatency;
+    ++entry.received;
+}
+
+LatencyProbeStatistics LatencyProbeTracker::getStatistics(uint16_t deviceId) const
+{
+    std::scoped_lock lock(sync);
+    LatencyProbeStatistics statistics;
+    const auto it = devices.find(deviceId);
+    if (it == devices.end() || it->second.received == 0)
+        return statistics;
+
+    const auto& entry = it->second;
+    const auto count = static_cast<size_t>(std::min<uint64_t>(entry.received, windowSize));
+    statistics.received = entry.received;
+
+    std::vector<int64_t> values(entry.transport.begin(), entry.transport.begin() + count);
+    statistics.transportMax = *std::max_element(values.begin(), values.end());
+    statistics.transportP50 = getPercentile(values, 50.0);
+    statistics.transportP99 = getPercentile(values, 99.0);
+
+    values.assign(entry.processing.begin(), entry.processing.begin() + count);
+    statistics.processingMax = *std::max_element(values.begin(), values.end());
+    statistics.processingP50 = getPercentile(values, 50.0);
+    statistics.processingP99 = getPercentile(values, 99.0);
+
+    return statistics;
+}
+
+void addLatencyProbeProperties(PropertyObjectPtr obj, std::function<LatencyProbeStatistics()> getStatistics)
+{
+    const auto addValue = [&obj, &getStatistics](const StringPtr& propName, auto value)
+    {
+        obj.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+        obj.getOnPropertyValueRead(propName) += [getStatistics, value](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+        { args.setValue(Integer(static_cast<Int>(getStatistics().*value))); };
+    };
+
+    addValue("LatencyProbesReceived", &LatencyProbeStatistics::received);
+    addValue("ProbeTransportLatencyP50", &LatencyProbeStatistics::transportP50);
+    addValue("ProbeTransportLatencyP99", &LatencyProbeStatistics::transportP99);
+    addValue("ProbeTransportLatencyMax", &LatencyProbeStatistics::transportMax);
+    addValue("ProbeProcessingLatencyP50", &LatencyProbeStatistics::processingP50);
+    addValue("ProbeProcessingLatencyP99", &LatencyProbeStatistics::processingP99);
+    addValue("ProbeProcessingLatencyMax", &LatencyProbeStatistics::processingMax);
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
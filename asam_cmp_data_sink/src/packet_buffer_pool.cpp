@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <new>
+
+#include <asam_cmp_data_sink/packet_buffer_pool.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    // Keeps the returned address aligned as malloc does
+    struct alignas(std::max_align_t) BufferHeader
+    {
+        size_t sizeClass;
+    };
+
+    constexpr size_t unpooledSizeClass = PacketBufferPool::sizeClassesCount;
+}
+
+PacketBufferPool::~PacketBufferPool()
+{
+    for (auto& buffers : freeBuffers)
+    {
+        for (auto buffer : buffers)
+            std::free(buffer);
+    }
+}
+
+size_t PacketBufferPool::getSizeClass(size_t size)
+{
+    size_t sizeClass = 0;
+    for (size_t classSize = minBufferSize; classSize < size && sizeClass < sizeClassesCount; classSize <<= 1)
+        ++sizeClass;
+
+    return sizeClass;
+}
+
+void* PacketBufferPool::allocate(size_t size)
+{
+    const auto sizeClass = getSizeClass(size);
+
+    void* buffer = nullptr;
+    if (sizeClass < sizeClassesCount)
+    {
+        std::scoped_lock lock(sync);
+        auto& buffers = freeBuffers[sizeClass];
+        if (!buffers.empty())
+        {
+            buffer = buffers.back();
+            buffers.pop_back();
+        }
+    }
+
+    if (!buffer)
+    {
+        const auto bufferSize = sizeClass < sizeClassesCount ? minBufferSize << sizeClass : size;
+        buffer = std::malloc(sizeof(BufferHeader) + bufferSize);
+        if (!buffer)
+            throw std::bad_alloc();
+        static_cast<BufferHeader*>(buffer)->sizeClass = sizeClass < sizeClassesCount ? sizeClass : unpooledSizeClass;
+    }
+
+    return static_cast<BufferHeader*>(buffer) + 1;
+}
+
+void PacketBufferPool::release(void* address)
+{
+    if (!address)
+        return;
+
+    auto buffer = static_cast<BufferHeader*>(address) - 1;
+    const auto sizeClass = buffer->sizeClass;
+    if (sizeClass < sizeClassesCount)
+    {
+        std::scoped_lock lock(sync);
+        auto& buffers = freeBuffers[sizeClass];
+        if (buffers.size() < maxCachedBuffersPerClass)
+        {
+            buffers.push_back(buffer);
+            return;
+        }
+    }
+
+    std::free(buffer);
+}
+
+size_t PacketBufferPool::getCachedBuffersCount() const
+{
+    std::scoped_lock lock(sync);
+
+    size_t count = 0;
+    for (const auto& buffers : freeBuffers)
+        count += buffers.size();
+
+    return count;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
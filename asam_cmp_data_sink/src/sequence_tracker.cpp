@@ -0,0 +1,223 @@
+#include <asam_cmp/cmp_header.h>
+#include <coreobjects/property_factory.h>
+#include <coreobjects/property_object_factory.h>
+#include <algorithm>
+
+#include <asam_cmp_data_sink/sequence_tracker.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    // CMP message header: version, reserved, device id, message type, stream id, sequence counter
+    constexpr size_t cmpHeaderSize = 8;
+    constexpr size_t deviceIdOffset = 2;
+    constexpr size_t messageTypeOffset = 4;
+    constexpr size_t streamIdOffset = 5;
+    constexpr size_t sequenceCounterOffset = 6;
+
+    uint16_t readUint16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+}
+
+SequenceTracker::SequenceTracker()
+    : devices(std::make_unique<std::atomic<DeviceEntry*>[]>(devicesCount))
+{
+}
+
+SequenceTracker::~SequenceTracker()
+{
+    for (size_t i = 0; i < devicesCount; ++i)
+        delete devices[i].load(std::memory_order_relaxed);
+}
+
+void SequenceTracker::track(const uint8_t* data, size_t size)
+{
+    // Status messages may share the counter of a data stream on the sender side, but they are not part of the stream
+    if (size < cmpHeaderSize || data[messageTypeOffset] != to_underlying(ASAM::CMP::CmpHeader::MessageType::data))
+        return;
+
+    track(readUint16(data + deviceIdOffset), data[streamIdOffset], readUint16(data + sequenceCounterOffset));
+}
+
+void SequenceTracker::track(uint16_t deviceId, uint8_t streamId, uint16_t sequenceCounter)
+{
+    auto& entry = getDeviceEntry(deviceId)[streamId];
+    entry.received.fetch_add(1, std::memory_order_relaxed);
+
+    if (entry.resync.load(std::memory_order_relaxed) && entry.resync.exchange(false, std::memory_order_acquire))
+    {
+        entry.initialized = false;
+        entry.windowExpected = 0;
+        entry.windowLost = 0;
+        entry.lossRate.store(0.0, std::memory_order_relaxed);
+    }
+
+    if (!lossTrackingRestricted.load(std::memory_order_relaxed) || entry.lossTracked.load(std::memory_order_relaxed))
+        trackLoss(entry, sequenceCounter);
+    else
+        entry.lastSequenceCounter = sequenceCounter;
+}
+
+void SequenceTracker::trackLoss(StreamEntry& entry, uint16_t sequenceCounter)
+{
+    if (!entry.initialized)
+    {
+        entry.initialized = true;
+        entry.lastSequenceCounter = sequenceCounter;
+        updateLossRate(entry, 1, 0);
+        return;
+    }
+
+    const auto distance = static_cast<int16_t>(static_cast<uint16_t>(sequenceCounter - entry.lastSequenceCounter));
+    if (distance > 0)
+    {
+        const uint64_t gap = distance - 1;
+        if (gap != 0)
+            entry.lost.fetch_add(gap, std::memory_order_relaxed);
+        entry.lastSequenceCounter = sequenceCounter;
+        updateLossRate(entry, distance, gap);
+    }
+    else if (distance == 0)
+    {
+        entry.duplicated.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (-distance <= maxReorderDistance)
+    {
+        entry.reordered.fetch_add(1, std::memory_order_relaxed);
+        // The message was counted as lost when the counter skipped over it
+        if (entry.lost.load(std::memory_order_relaxed) != 0)
+            entry.lost.fetch_sub(1, std::memory_order_relaxed);
+        if (entry.windowLost != 0)
+            --entry.windowLost;
+    }
+    else
+    {
+        // Too far behind to be a late message, the sender has most likely restarted
+        entry.lastSequenceCounter = sequenceCounter;
+    }
+}
+
+void SequenceTracker::setLossTrackedStreams(const std::set<StreamKey>& streams)
+{
+    lossTrackingRestricted = true;
+
+    std::vector<uint16_t> deviceIds;
+    {
+        std::scoped_lock lock{allocatedDevicesSync};
+        deviceIds = allocatedDevices;
+    }
+
+    for (const auto deviceId : deviceIds)
+    {
+        auto& device = *devices[deviceId].load(std::memory_order_acquire);
+        for (size_t streamId = 0; streamId < device.size(); ++streamId)
+            setLossTracked(device[streamId], streams.count({deviceId, static_cast<uint8_t>(streamId)}) != 0);
+    }
+
+    // Streams not seen yet get their entries now, so the flag is in place for their first message
+    for (const auto& [deviceId, streamId] : streams)
+        setLossTracked(getDeviceEntry(deviceId)[streamId], true);
+}
+
+void SequenceTracker::setLossTracked(StreamEntry& entry, bool tracked)
+{
+    if (entry.lossTracked.exchange(tracked, std::memory_order_relaxed) != tracked)
+        entry.resync.store(true, std::memory_order_release);
+}
+
+SequenceStatistics SequenceTracker::getStatistics(uint16_t deviceId, uint8_t streamId) const
+{
+    const auto device = devices[deviceId].load(std::memory_order_acquire);
+    if (device == nullptr)
+        return {};
+
+    return loadStatistics((*device)[streamId]);
+}
+
+SequenceStatistics SequenceTracker::getStatistics(uint16_t deviceId) const
+{
+    SequenceStatistics statistics;
+
+    const auto device = devices[deviceId].load(std::memory_order_acquire);
+    if (device == nullptr)
+        return statistics;
+
+    for (const auto& entry : *device)
+    {
+        const auto streamStatistics = loadStatistics(entry);
+        statistics.received += streamStatistics.received;
+        statistics.lost += streamStatistics.lost;
+        statistics.duplicated += streamStatistics.duplicated;
+        statistics.reordered += streamStatistics.reordered;
+        statistics.lossRate = std::max(statistics.lossRate, streamStatistics.lossRate);
+    }
+
+    return statistics;
+}
+
+SequenceTracker::DeviceEntry& SequenceTracker::getDeviceEntry(uint16_t deviceId)
+{
+    auto device = devices[deviceId].load(std::memory_order_acquire);
+    if (device != nullptr)
+        return *device;
+
+    // The capture thread and setLossTrackedStreams may add the same device at the same time
+    auto newDevice = std::make_unique<DeviceEntry>();
+    if (devices[deviceId].compare_exchange_strong(device, newDevice.get(), std::memory_order_acq_rel))
+    {
+        std::scoped_lock lock{allocatedDevicesSync};
+        allocatedDevices.push_back(deviceId);
+        return *newDevice.release();
+    }
+
+    return *device;
+}
+
+void SequenceTracker::updateLossRate(StreamEntry& entry, uint64_t expected, uint64_t lost)
+{
+    entry.windowExpected += expected;
+    entry.windowLost += lost;
+    if (entry.windowExpected < lossRateWindow)
+        return;
+
+    entry.lossRate.store(static_cast<double>(entry.windowLost) / static_cast<double>(entry.windowExpected), std::memory_order_relaxed);
+    entry.windowExpected = 0;
+    entry.windowLost = 0;
+}
+
+SequenceStatistics SequenceTracker::loadStatistics(const StreamEntry& entry)
+{
+    SequenceStatistics statistics;
+    statistics.received = entry.received.load(std::memory_order_relaxed);
+    statistics.lost = entry.lost.load(std::memory_order_relaxed);
+    statistics.duplicated = entry.duplicated.load(std::memory_order_relaxed);
+    statistics.reordered = entry.reordered.load(std::memory_order_relaxed);
+    statistics.lossRate = entry.lossRate.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+void addSequenceStatisticsProperties(PropertyObjectPtr obj, std::function<SequenceStatistics()> getStatistics)
+{
+    const auto addCounter = [&obj, &getStatistics](const StringPtr& propName, uint64_t SequenceStatistics::*counter)
+    {
+        obj.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+        obj.getOnPropertyValueRead(propName) += [getStatistics, counter](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+        { args.setValue(Integer(static_cast<Int>(getStatistics().*counter))); };
+    };
+
+    addCounter("ReceivedMessages", &SequenceStatistics::received);
+    addCounter("LostMessages", &SequenceStatistics::lost);
+    addCounter("DuplicatedMessages", &SequenceStatistics::duplicated);
+    addCounter("ReorderedMessages", &SequenceStatistics::reordered);
+
+    const StringPtr propName = "LossRate";
+    obj.addProperty(FloatPropertyBuilder(propName, 0.0).setReadOnly(true).build());
+    obj.getOnPropertyValueRead(propName) += [getStatistics](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(Floating(getStatistics().lossRate)); };
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,114 @@
+#include <asam_cmp/decoder.h>
+#include <asam_cmp/encoder.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <asam_cmp_data_sink/status_cache.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    // File layout: magic with the format version, then every encoded frame preceded by its big-endian length
+    constexpr std::array<char, 8> fileMagic{'A', 'C', 'M', 'P', 'S', 'T', 'C', '1'};
+    constexpr size_t frameLengthSize = 2;
+
+    std::string getFileName(const std::string& adapterName)
+    {
+        // Adapter names like \Device\NPF_{GUID} are not valid file names
+        std::string name = adapterName;
+        std::replace_if(
+            name.begin(), name.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.'; }, '_');
+        return "asam_cmp_status_" + name + ".cache";
+    }
+
+    void writeFrame(std::ofstream& file, const std::vector<uint8_t>& frame)
+    {
+        const std::array<char, frameLengthSize> length{static_cast<char>(frame.size() >> 8), static_cast<char>(frame.size() & 0xFF)};
+        file.write(length.data(), length.size());
+        file.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(frame.size()));
+    }
+
+    void writePacket(std::ofstream& file, ASAM::CMP::Encoder& encoder, const ASAM::CMP::Packet& packet)
+    {
+        for (const auto& frame : encoder.encode(packet, {64, 1500}))
+            writeFrame(file, frame);
+    }
+}
+
+StatusCache::StatusCache(const std::filesystem::path& directory, const std::string& adapterName)
+    : adapterName(adapterName)
+    , filePath(directory / getFileName(adapterName))
+{
+}
+
+const std::string& StatusCache::getAdapterName() const
+{
+    return adapterName;
+}
+
+const std::filesystem::path& StatusCache::getFilePath() const
+{
+    return filePath;
+}
+
+std::vector<std::shared_ptr<ASAM::CMP::Packet>> StatusCache::load() const
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        return {};
+
+    const std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (data.size() < fileMagic.size() || !std::equal(fileMagic.begin(), fileMagic.end(), data.begin()))
+        throw std::runtime_error("Status cache " + filePath.string() + " has an unknown format");
+
+    ASAM::CMP::Decoder decoder;
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> packets;
+    for (size_t pos = fileMagic.size(); pos < data.size();)
+    {
+        if (data.size() - pos < frameLengthSize)
+            throw std::runtime_error("Status cache " + filePath.string() + " is truncated");
+        const size_t frameSize = (static_cast<size_t>(data[pos]) << 8) | data[pos + 1];
+        pos += frameLengthSize;
+        if (data.size() - pos < frameSize)
+            throw std::runtime_error("Status cache " + filePath.string() + " is truncated");
+
+        auto framePackets = decoder.decode(data.data() + pos, frameSize);
+        std::move(framePackets.begin(), framePackets.end(), std::back_inserter(packets));
+        pos += frameSize;
+    }
+
+    return packets;
+}
+
+void StatusCache::save(const ASAM::CMP::Status& status) const
+{
+    auto tmpPath = filePath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(fileMagic.data(), fileMagic.size());
+
+        for (size_t i = 0; i < status.getDeviceStatusCount(); ++i)
+        {
+            const auto& deviceStatus = status.getDeviceStatus(i);
+            ASAM::CMP::Encoder encoder;
+            encoder.setDeviceId(deviceStatus.getPacket().getDeviceId());
+
+            writePacket(file, encoder, deviceStatus.getPacket());
+            for (size_t j = 0; j < deviceStatus.getInterfaceStatusCount(); ++j)
+                writePacket(file, encoder, deviceStatus.getInterfaceStatus(j).getPacket());
+        }
+
+        if (!file)
+            throw std::runtime_error("Status cache " + tmpPath.string() + " can't be written");
+    }
+
+    std::filesystem::rename(tmpPath, filePath);
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -1,4 +1,5 @@
 #include <asam_cmp/capture_module_payload.h>
+#include <asam_cmp/interface_payload.h>
 #include <coreobjects/callable_info_factory.h>
 
 #include <asam_cmp_data_sink/status_fb_impl.h>
@@ -16,11 +17,76 @@ FunctionBlockTypePtr StatusFbImpl::CreateType()
     return FunctionBlockType("asam_cmp_status", "AsamCmpStatus", "ASAM CMP Status");
 }
 
+namespace
+{
+    using ASAM::CMP::CaptureModulePayload;
+    using ASAM::CMP::InterfacePayload;
+
+    bool isSamePayload(const CaptureModulePayload& lhs, const CaptureModulePayload& rhs)
+    {
+        return lhs.getDeviceDescription() == rhs.getDeviceDescription() && lhs.getSerialNumber() == rhs.getSerialNumber() &&
+               lhs.getHardwareVersion() == rhs.getHardwareVersion() && lhs.getSoftwareVersion() == rhs.getSoftwareVersion() &&
+               lhs.getVendorDataStringView() == rhs.getVendorDataStringView();
+    }
+
+    bool isSamePayload(const InterfacePayload& lhs, const InterfacePayload& rhs)
+    {
+        if (lhs.getInterfaceType() != rhs.getInterfaceType() || lhs.getInterfaceStatus() != rhs.getInterfaceStatus() ||
+            lhs.getStreamIdsCount() != rhs.getStreamIdsCount())
+            return false;
+
+        const auto lhsStreamIds = lhs.getStreamIds();
+        const auto rhsStreamIds = rhs.getStreamIds();
+        for (uint16_t i = 0; i < lhs.getStreamIdsCount(); ++i)
+        {
+            if (lhsStreamIds[i] != rhsStreamIds[i])
+                return false;
+        }
+
+        return true;
+    }
+}
+
+// Only the fields the sink consumes are compared, so periodic counter updates do not cause a refresh
+bool StatusFbImpl::isStatusChanged(const ASAM::CMP::Packet& packet) const
+{
+    const size_t index = status.getIndexByDeviceId(packet.getDeviceId());
+    // Interface statuses of unknown capture modules are dropped by Status::update
+    if (index >= status.getDeviceStatusCount())
+        return packet.getPayload().getType() == ASAM::CMP::PayloadType::cmStatMsg;
+
+    const auto& deviceStatus = status.getDeviceStatus(index);
+    switch (packet.getPayload().getType())
+    {
+        case ASAM::CMP::PayloadType::cmStatMsg:
+            return !isSamePayload(static_cast<const CaptureModulePayload&>(deviceStatus.getPacket().getPayload()),
+                                  static_cast<const CaptureModulePayload&>(packet.getPayload()));
+        case ASAM::CMP::PayloadType::ifStatMsg:
+        {
+            const auto& payload = static_cast<const InterfacePayload&>(packet.getPayload());
+            for (size_t i = 0; i < deviceStatus.getInterfaceStatusCount(); ++i)
+            {
+                const auto& interfaceStatus = deviceStatus.getInterfaceStatus(i);
+                const auto& storedPayload = static_cast<const InterfacePayload&>(interfaceStatus.getPacket().getPayload());
+                if (storedPayload.getInterfaceId() == payload.getInterfaceId())
+                    return !isSamePayload(storedPayload, payload);
+            }
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
 void StatusFbImpl::processStatusPacket(const std::shared_ptr<ASAM::CMP::Packet>& packet)
 {
-    std::scoped_lock lock(stMutex, sync);
+    std::unique_lock statusLock(stMutex);
+    if (!isStatusChanged(*packet))
+        return;
 
+    std::scoped_lock lock(sync);
     status.update(*packet);
+    statusStore.publish(status);
 
     size_t index = status.getIndexByDeviceId(packet->getDeviceId());
     // If an Interface status packet came before a Capture status packet
@@ -45,7 +111,7 @@ void StatusFbImpl::processStatusPacket(const std::shared_ptr<ASAM::CMP::Packet>&
 
 StatusMt StatusFbImpl::getStatusMt() const
 {
-    return StatusMt(status, stMutex);
+    return StatusMt(statusStore);
 }
 
 void StatusFbImpl::initProperties()
@@ -66,6 +132,7 @@ void StatusFbImpl::clear()
     std::scoped_lock lock{stMutex, sync};
 
     status.clear();
+    statusStore.publish(status);
     objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue("CaptureModuleList", List<IString>());
 }
 
@@ -1,5 +1,8 @@
+#include <opendaq/deleter_factory.h>
 #include <opendaq/dimension_factory.h>
 
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_common_lib/trace_recorder.h>
 #include <asam_cmp_common_lib/unit_converter.h>
 #include <asam_cmp_data_sink/stream_fb.h>
 
@@ -10,52 +13,151 @@ StreamFb::StreamFb(const ContextPtr& ctx,
                    const StringPtr& localId,
                    const asam_cmp_common_lib::StreamCommonInit& init,
                    DataPacketsPublisher& publisher,
+                   SequenceTracker& sequenceTracker,
                    const uint16_t& deviceId,
                    const uint32_t& interfaceId)
     : StreamCommonFbImpl(ctx, parent, localId, init)
     , deviceId(deviceId)
     , interfaceId(interfaceId)
     , publisher(publisher)
+    , sequenceTracker(sequenceTracker)
     , updateDescriptors(init.payloadType == PayloadType::analog)
+    , bufferPool(std::make_shared<PacketBufferPool>())
+    , bufferDeleter(Deleter([pool = bufferPool](void* address) { pool->release(address); }))
+    , flushTimer(FlushTimer::getInstance())
 {
+    initProperties();
     createSignals();
     buildDataDescriptor();
     buildAsyncDomainDescriptor();
 }
 
-void StreamFb::setPayloadType(PayloadType type)
+StreamFb::~StreamFb()
 {
-    updateDescriptors = payloadType == PayloadType::analog || type == PayloadType::analog;
-    StreamCommonFbImpl::setPayloadType(type);
+    flushTimer->cancel(this);
+}
 
-    if (payloadType != PayloadType::analog)
+void StreamFb::initProperties()
+{
+    // Payload specific properties are shown only for the payload type of the parent interface
+    objPtr.addProperty(BoolPropertyBuilder("IsAnalogPayload", payloadType == PayloadType::analog).setReadOnly(true).setVisible(false).build());
+    objPtr.addProperty(BoolPropertyBuilder("IsCanPayload", isCanPayload()).setReadOnly(true).setVisible(false).build());
+    objPtr.addProperty(BoolPropertyBuilder("IsCanClassicPayload", payloadType == PayloadType::can).setReadOnly(true).setVisible(false).build());
+
+    StringPtr propName = "AnalogCoalescing";
+    objPtr.addProperty(BoolPropertyBuilder(propName, False).setVisible(EvalValue("$IsAnalogPayload")).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
     {
+        const bool enabled = args.getValue();
+        coalescingEnabled = enabled;
+        if (!enabled)
+        {
+            std::scoped_lock lock(dataSync);
+            flushCoalescedData();
+        }
+    };
+
+    propName = "MaxCoalescedSamples";
+    objPtr.addProperty(
+        IntPropertyBuilder(propName, static_cast<Int>(maxCoalescedSamples)).setMinValue(1).setVisible(EvalValue("$IsAnalogPayload")).build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { maxCoalescedSamples = static_cast<Int>(args.getValue()); };
+
+    propName = "MaxCoalescingLatency";
+    objPtr.addProperty(IntPropertyBuilder(propName, static_cast<Int>(maxCoalescingLatency.load().count()))
+                           .setMinValue(0)
+                           .setVisible(EvalValue("$IsAnalogPayload"))
+                           .build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { maxCoalescingLatency = std::chrono::milliseconds(static_cast<Int>(args.getValue())); };
+
+    propName = "CanBatchSize";
+    objPtr.addProperty(IntPropertyBuilder(propName, static_cast<Int>(canBatchSize)).setMinValue(1).setVisible(EvalValue("$IsCanPayload")).build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { canBatchSize = static_cast<Int>(args.getValue()); };
+
+    propName = "CanBatchMaxDelay";
+    objPtr.addProperty(IntPropertyBuilder(propName, static_cast<Int>(canBatchMaxDelay.load().count()))
+                           .setMinValue(0)
+                           .setVisible(EvalValue("$IsCanPayload"))
+                           .build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { canBatchMaxDelay = std::chrono::milliseconds(static_cast<Int>(args.getValue())); };
+
+    propName = "CompactCanData";
+    objPtr.addProperty(BoolPropertyBuilder(propName, False).setVisible(EvalValue("$IsCanClassicPayload")).build());
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        std::scoped_lock lock(dataSync);
+        flushCanBatch();
+        compactCanData = args.getValue();
         buildDataDescriptor();
-        if (updateDescriptors)
+    };
+
+    addSequenceStatisticsProperties(objPtr, [this] { return sequenceTracker.getStatistics(deviceId, streamId); });
+}
+
+void StreamFb::setPayloadType(PayloadType type)
+{
+    {
+        std::scoped_lock lock(dataSync);
+        flushCoalescedData();
+        flushCanBatch();
+
+        updateDescriptors = payloadType == PayloadType::analog || type == PayloadType::analog;
+        StreamCommonFbImpl::setPayloadType(type);
+
+        if (payloadType != PayloadType::analog)
         {
-            buildAsyncDomainDescriptor();
-            updateDescriptors = false;
+            buildDataDescriptor();
+            if (updateDescriptors)
+            {
+                buildAsyncDomainDescriptor();
+                updateDescriptors = false;
+            }
         }
     }
+    updatePayloadTypeProperties();
+}
+
+void StreamFb::updatePayloadTypeProperties()
+{
+    setPropertyValueInternal(String("IsAnalogPayload").asPtr<IString>(true),
+                             BaseObjectPtr(payloadType == PayloadType::analog).asPtr<IBaseObject>(true),
+                             false,
+                             true,
+                             false);
+    setPropertyValueInternal(
+        String("IsCanPayload").asPtr<IString>(true), BaseObjectPtr(isCanPayload()).asPtr<IBaseObject>(true), false, true, false);
+    setPropertyValueInternal(String("IsCanClassicPayload").asPtr<IString>(true),
+                             BaseObjectPtr(payloadType == PayloadType::can).asPtr<IBaseObject>(true),
+                             false,
+                             true,
+                             false);
+}
+
+bool StreamFb::isCanPayload() const
+{
+    return payloadType == PayloadType::can || payloadType == PayloadType::canFd;
 }
 
 void StreamFb::receive(const std::shared_ptr<Packet>& packet)
 {
+    std::scoped_lock lock(dataSync);
+
     if (packet->getPayload().getType() != payloadType)
         return;
 
     if (payloadType == PayloadType::analog)
         processSyncData(packet);
     else
-    {
-        std::vector<std::shared_ptr<Packet>> packets;
-        packets.emplace_back(packet);
-        receive(packets);
-    }
+        batchAsyncData({packet});
 }
 
 void StreamFb::receive(const std::vector<std::shared_ptr<Packet>>& packets)
 {
+    std::scoped_lock lock(dataSync);
+
     if (packets.front()->getPayload().getType() != payloadType)
         return;
 
@@ -66,7 +168,7 @@ void StreamFb::receive(const std::vector<std::shared_ptr<Packet>>& packets)
     }
     else
     {
-        processAsyncData(packets);
+        batchAsyncData(packets);
     }
 }
 
@@ -96,14 +198,19 @@ void StreamFb::buildDataDescriptor()
     {
         case PayloadType::can:
         case PayloadType::canFd:
-            buildCanDescriptor();
+            buildCanDescriptor(isCompactCanData() ? sizeof(CANClassicData::data) : sizeof(CANData::data));
             break;
         case PayloadType::analog:
             break;
     }
 }
 
-void StreamFb::buildCanDescriptor()
+bool StreamFb::isCompactCanData() const
+{
+    return compactCanData && payloadType == PayloadType::can;
+}
+
+void StreamFb::buildCanDescriptor(size_t dataLength)
 {
     const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
     const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
@@ -112,7 +219,7 @@ void StreamFb::buildCanDescriptor()
         DataDescriptorBuilder()
             .setName("Data")
             .setSampleType(SampleType::UInt8)
-            .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+            .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, dataLength)).setName("Dimension").build()))
             .build();
 
     const auto canMsgDescriptor = DataDescriptorBuilder()
@@ -178,40 +285,98 @@ void StreamFb::buildSyncDomainDescriptor(const float sampleInterval)
     analogHeader.setSampleInterval(sampleInterval);
 }
 
+void StreamFb::batchAsyncData(const std::vector<std::shared_ptr<Packet>>& packets)
+{
+    if (canBatchSize <= 1 && canBatch.empty())
+    {
+        processAsyncData(packets);
+        return;
+    }
+
+    if (canBatch.empty())
+        setFlushDeadline(canBatchMaxDelay.load());
+
+    canBatch.insert(canBatch.end(), packets.begin(), packets.end());
+    if (canBatch.size() >= canBatchSize)
+        flushCanBatch();
+}
+
+void StreamFb::flushCanBatch()
+{
+    if (canBatch.empty())
+        return;
+
+    processAsyncData(canBatch);
+    canBatch.clear();
+    flushDeadline = 0;
+}
+
+// The timer is scheduled only while a batch or coalesced block is pending. A deadline that outlives an early flush is
+// not cancelled, since cancel waits for running callbacks and dataSync is held here; flushExpired ignores it.
+void StreamFb::setFlushDeadline(FlushTimer::Clock::duration delay)
+{
+    const auto deadline = FlushTimer::Clock::now() + delay;
+    flushDeadline = deadline.time_since_epoch().count();
+    flushTimer->schedule(this, deadline, [this](FlushTimer::Clock::time_point now) { flushExpired(now); });
+}
+
+void StreamFb::flushExpired(FlushTimer::Clock::time_point now)
+{
+    const auto deadline = flushDeadline.load();
+    if (deadline == 0 || now.time_since_epoch().count() < deadline)
+        return;
+
+    std::scoped_lock lock(dataSync);
+    flushCoalescedData();
+    flushCanBatch();
+}
+
 void StreamFb::processAsyncData(const std::vector<std::shared_ptr<Packet>>& packets)
 {
+    ASAM_CMP_LATENCY_SCOPE(packetCreation);
+    ASAM_CMP_TRACE_SCOPE("SinkStreamAsyncData");
+
     const uint64_t newSamples = packets.size();
     auto timestamp = packets.front()->getTimestamp();
 
-    const auto domainPacket = DataPacket(domainSignal.getDescriptor(), newSamples, timestamp);
+    const auto domainPacket = createPooledPacket(nullptr, domainSignal.getDescriptor(), newSamples, timestamp);
     auto domainBuffer = static_cast<uint64_t*>(domainPacket.getRawData());
 
-    const auto dataPacket = DataPacketWithDomain(domainPacket, dataSignal.getDescriptor(), newSamples);
-    auto buffer = reinterpret_cast<CANData*>(dataPacket.getRawData());
+    const auto dataPacket = createPooledPacket(domainPacket, dataSignal.getDescriptor(), newSamples, nullptr);
 
-    for (auto& packet : packets)
+    switch (payloadType.getType())
     {
-        switch (payloadType.getType())
-        {
-            case PayloadType::can:
-            case PayloadType::canFd:
-                fillCanData(buffer, packet);
-                break;
-        }
-        *domainBuffer++ = packet->getTimestamp();
-        buffer++;
+        case PayloadType::can:
+        case PayloadType::canFd:
+            if (isCompactCanData())
+                fillCanSamples<CANClassicData>(dataPacket.getRawData(), domainBuffer, packets);
+            else
+                fillCanSamples<CANData>(dataPacket.getRawData(), domainBuffer, packets);
+            break;
     }
 
     dataSignal.sendPacket(dataPacket);
     domainSignal.sendPacket(domainPacket);
 }
 
-void StreamFb::fillCanData(CANData* const data, const std::shared_ptr<Packet>& packet)
+template <typename CanDataType>
+void StreamFb::fillCanSamples(void* buffer, uint64_t* domainBuffer, const std::vector<std::shared_ptr<Packet>>& packets)
+{
+    auto data = static_cast<CanDataType*>(buffer);
+    for (auto& packet : packets)
+    {
+        fillCanData(data++, packet);
+        *domainBuffer++ = packet->getTimestamp();
+    }
+}
+
+template <typename CanDataType>
+void StreamFb::fillCanData(CanDataType* const data, const std::shared_ptr<Packet>& packet)
 {
     auto& payload = static_cast<const CanPayload&>(packet->getPayload());
 
     data->arbId = payload.getId();
-    data->length = payload.getDataLength();
+    data->length = static_cast<uint8_t>(std::min<size_t>(payload.getDataLength(), sizeof(data->data)));
     memcpy(data->data, payload.getData(), data->length);
 }
 
@@ -219,6 +384,9 @@ void StreamFb::processSyncData(const std::shared_ptr<Packet>& packet)
 {
     auto& analogPayload = static_cast<const AnalogPayload&>(packet->getPayload());
 
+    if (updateDescriptors || domainChanged(analogPayload) || dataChanged(analogPayload))
+        flushCoalescedData();
+
     if (updateDescriptors)
     {
         buildSyncDomainDescriptor(analogPayload.getSampleInterval());
@@ -237,19 +405,91 @@ void StreamFb::processSyncData(const std::shared_ptr<Packet>& packet)
         }
     }
 
-    const auto sampleCount = analogPayload.getSamplesCount();
+    if (coalescingEnabled)
+    {
+        coalesceSyncData(packet);
+    }
+    else
+    {
+        flushCoalescedData();
+        sendSyncData(packet->getTimestamp(), analogPayload.getData(), analogPayload.getSamplesCount());
+    }
+}
+
+void StreamFb::coalesceSyncData(const std::shared_ptr<Packet>& packet)
+{
+    auto& analogPayload = static_cast<const AnalogPayload&>(packet->getPayload());
     const auto timestamp = packet->getTimestamp();
 
+    if (coalescedSamples != 0)
+    {
+        const auto deltaT = getDeltaT(analogHeader.getSampleInterval());
+        const auto expectedTimestamp = coalescedTimestamp + coalescedSamples * deltaT;
+        const auto jitter = timestamp > expectedTimestamp ? timestamp - expectedTimestamp : expectedTimestamp - timestamp;
+        if (jitter * 2 > static_cast<uint64_t>(deltaT))
+            flushCoalescedData();
+    }
+
+    if (coalescedSamples == 0)
+    {
+        coalescedTimestamp = timestamp;
+        coalescingStartTime = std::chrono::steady_clock::now();
+        setFlushDeadline(maxCoalescingLatency.load());
+    }
+
+    const auto sampleSize = analogPayload.getSampleDt() == AnalogPayload::SampleDt::aInt16 ? sizeof(int16_t) : sizeof(int32_t);
+    const auto data = analogPayload.getData();
+    coalescedData.insert(coalescedData.end(), data, data + analogPayload.getSamplesCount() * sampleSize);
+    coalescedSamples += analogPayload.getSamplesCount();
+
+    if (coalescedSamples >= maxCoalescedSamples || std::chrono::steady_clock::now() - coalescingStartTime >= maxCoalescingLatency.load())
+        flushCoalescedData();
+}
+
+void StreamFb::flushCoalescedData()
+{
+    if (coalescedSamples == 0)
+        return;
+
+    sendSyncData(coalescedTimestamp, coalescedData.data(), coalescedSamples);
+    coalescedData.clear();
+    coalescedSamples = 0;
+    flushDeadline = 0;
+}
+
+void StreamFb::sendSyncData(uint64_t timestamp, const void* data, size_t sampleCount)
+{
+    ASAM_CMP_LATENCY_SCOPE(packetCreation);
+    ASAM_CMP_TRACE_SCOPE("SinkStreamSyncData");
+
     const auto domainPacket = DataPacket(domainSignal.getDescriptor(), sampleCount, timestamp);
-    const auto dataPacket = DataPacketWithDomain(domainPacket, dataSignal.getDescriptor(), sampleCount);
+    const auto dataPacket = createPooledPacket(domainPacket, dataSignal.getDescriptor(), sampleCount, nullptr);
     const auto buffer = dataPacket.getRawData();
 
-    memcpy(buffer, analogPayload.getData(), dataPacket.getRawDataSize());
+    memcpy(buffer, data, dataPacket.getRawDataSize());
 
     dataSignal.sendPacket(dataPacket);
     domainSignal.sendPacket(domainPacket);
 }
 
+DataPacketPtr StreamFb::createPooledPacket(const DataPacketPtr& domainPacket,
+                                           const DataDescriptorPtr& descriptor,
+                                           uint64_t sampleCount,
+                                           const NumberPtr& offset)
+{
+    const SizeT bufferSize = sampleCount * descriptor.getRawSampleSize();
+    auto buffer = bufferPool->allocate(bufferSize);
+    try
+    {
+        return DataPacketWithExternalMemory(domainPacket, descriptor, sampleCount, buffer, bufferDeleter, offset, bufferSize);
+    }
+    catch (...)
+    {
+        bufferPool->release(buffer);
+        throw;
+    }
+}
+
 bool StreamFb::domainChanged(const AnalogPayload& payload)
 {
     return payload.getSampleInterval() != analogHeader.getSampleInterval();
@@ -286,7 +526,7 @@ Int StreamFb::getDeltaT(float sampleInterval)
 
 UnitPtr StreamFb::asamCmpToOpenDaqUnit(AnalogPayload::Unit asamCmpUnit)
 {
-    const auto symbol = asam_cmp_common_lib::Units::getSymbolById(to_underlying(asamCmpUnit));
+    const std::string symbol{asam_cmp_common_lib::Units::getSymbolById(to_underlying(asamCmpUnit))};
     return Unit(symbol, -1, "", "");
 }
 
@@ -17,12 +17,20 @@ protected:
     {
         auto logger = Logger();
         captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::CaptureFb>(
-            Context(Scheduler(logger), logger, nullptr, nullptr, nullptr), nullptr, "capture_module_0", publisher, capturePacketsPublisher);
+            Context(Scheduler(logger), logger, nullptr, nullptr, nullptr),
+            nullptr,
+            "capture_module_0",
+            publisher,
+            capturePacketsPublisher,
+            sequenceTracker,
+            latencyProbeTracker);
     }
 
 protected:
     modules::asam_cmp_data_sink_module::DataPacketsPublisher publisher;
     modules::asam_cmp_data_sink_module::CapturePacketsPublisher capturePacketsPublisher;
+    modules::asam_cmp_data_sink_module::SequenceTracker sequenceTracker;
+    modules::asam_cmp_data_sink_module::LatencyProbeTracker latencyProbeTracker;
     FunctionBlockPtr captureFb;
 };
 
@@ -150,3 +158,31 @@ TEST_F(CaptureFbTest, TestBeginUpdateEndUpdate)
     ASSERT_NO_THROW(createProc());
     ASSERT_NO_THROW(removeProc(0));
 }
+
+TEST_F(CaptureFbTest, SequenceStatistics)
+{
+    captureFb.setPropertyValue("DeviceId", 5);
+    sequenceTracker.track(5, 1, 0);
+    sequenceTracker.track(5, 1, 3);
+    sequenceTracker.track(5, 2, 0);
+
+    ASSERT_EQ(captureFb.getPropertyValue("ReceivedMessages"), 3);
+    ASSERT_EQ(captureFb.getPropertyValue("LostMessages"), 2);
+    ASSERT_EQ(captureFb.getPropertyValue("DuplicatedMessages"), 0);
+    ASSERT_EQ(captureFb.getPropertyValue("ReorderedMessages"), 0);
+    EXPECT_THROW(captureFb.setPropertyValue("LostMessages", 0), daq::AccessDeniedException);
+}
+
+TEST_F(CaptureFbTest, LatencyProbeStatistics)
+{
+    captureFb.setPropertyValue("DeviceId", 5);
+    for (int64_t latency = 1; latency <= 100; ++latency)
+        latencyProbeTracker.record(5, latency * 1000, latency * 2000);
+    latencyProbeTracker.record(6, 1, 1);
+
+    ASSERT_EQ(captureFb.getPropertyValue("LatencyProbesReceived"), 100);
+    ASSERT_EQ(captureFb.getPropertyValue("ProbeTransportLatencyP50"), 51000);
+    ASSERT_EQ(captureFb.getPropertyValue("ProbeTransportLatencyMax"), 100000);
+    ASSERT_EQ(captureFb.getPropertyValue("ProbeProcessingLatencyMax"), 200000);
+    EXPECT_THROW(captureFb.setPropertyValue("LatencyProbesReceived", 0), daq::AccessDeniedException);
+}
@@ -0,0 +1,71 @@
+#include <asam_cmp/capture_module_payload.h>
+#include <asam_cmp/cmp_header.h>
+#include <asam_cmp/interface_payload.h>
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/capture_filter.h>
+
+using daq::modules::asam_cmp_data_sink_module::createCaptureFilter;
+using daq::modules::asam_cmp_data_sink_module::Endpoint;
+using daq::modules::asam_cmp_data_sink_module::getFullyCapturedStreams;
+
+TEST(CaptureFilterTest, StatusOnly)
+{
+    ASSERT_EQ(createCaptureFilter({}), "ether[18] == 3 or ether[18] == 255");
+}
+
+TEST(CaptureFilterTest, SingleEndpoint)
+{
+    const std::string expected = "ether[18] == 3 or ether[18] == 255 or (ether[18] == 1 and ether[16:2] == 2 and ether[19] == 4 and "
+                                 "(ether[36:2] + 54 <= len or ether[30:4] == 3))";
+    ASSERT_EQ(createCaptureFilter({{2, 3, 4}}), expected);
+}
+
+TEST(CaptureFilterTest, InterfacesOfSameStreamAreGrouped)
+{
+    const std::string expected = "ether[18] == 3 or ether[18] == 255 or (ether[18] == 1 and ether[16:2] == 1 and ether[19] == 1 and "
+                                 "(ether[36:2] + 54 <= len or ether[30:4] == 1 or ether[30:4] == 2))";
+    ASSERT_EQ(createCaptureFilter({{1, 2, 1}, {1, 1, 1}}), expected);
+}
+
+TEST(CaptureFilterTest, DifferentStreams)
+{
+    const auto filter = createCaptureFilter({{1, 1, 1}, {1, 1, 2}, {2, 1, 1}});
+    ASSERT_NE(filter.find("ether[16:2] == 1 and ether[19] == 1"), std::string::npos);
+    ASSERT_NE(filter.find("ether[16:2] == 1 and ether[19] == 2"), std::string::npos);
+    ASSERT_NE(filter.find("ether[16:2] == 2 and ether[19] == 1"), std::string::npos);
+}
+
+TEST(CaptureFilterTest, FullyCapturedStreams)
+{
+    constexpr uint16_t deviceId = 2;
+    ASAM::CMP::Status status;
+
+    ASAM::CMP::CaptureModulePayload cmPayload;
+    cmPayload.setData("Device", "Serial", "HW", "SW", {});
+    ASAM::CMP::Packet cmPacket;
+    cmPacket.setPayload(cmPayload);
+    cmPacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+    cmPacket.setDeviceId(deviceId);
+    status.update(cmPacket);
+
+    // Interfaces 0 and 1 share stream 1, stream 2 is on interface 1 only
+    const std::vector<std::vector<uint8_t>> interfaceStreams = {{1}, {1, 2}};
+    for (uint32_t interfaceId = 0; interfaceId < interfaceStreams.size(); ++interfaceId)
+    {
+        const auto& streams = interfaceStreams[interfaceId];
+        ASAM::CMP::InterfacePayload ifPayload;
+        ifPayload.setInterfaceId(interfaceId);
+        ifPayload.setData(streams.data(), static_cast<uint16_t>(streams.size()), nullptr, 0);
+        ASAM::CMP::Packet ifPacket;
+        ifPacket.setPayload(ifPayload);
+        ifPacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+        ifPacket.setDeviceId(deviceId);
+        status.update(ifPacket);
+    }
+
+    using Streams = std::set<std::pair<uint16_t, uint8_t>>;
+    ASSERT_EQ(getFullyCapturedStreams({}, status), Streams{});
+    ASSERT_EQ(getFullyCapturedStreams({{deviceId, 1, 1}, {deviceId, 1, 2}}, status), (Streams{{deviceId, 2}}));
+    ASSERT_EQ(getFullyCapturedStreams({{deviceId, 0, 1}, {deviceId, 1, 1}}, status), (Streams{{deviceId, 1}}));
+}
@@ -27,7 +27,14 @@ protected:
         statusHandler = statusFb.asPtrOrNull<IStatusHandler>();
 
         funcBlock = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::DataSinkFb>(
-            context, nullptr, "asam_cmp_data_sink", statusHandler->getStatusMt(), publisher, capturePacketPublisher);
+            context,
+            nullptr,
+            "asam_cmp_data_sink",
+            statusHandler->getStatusMt(),
+            publisher,
+            capturePacketPublisher,
+            sequenceTracker,
+            latencyProbeTracker);
 
         CaptureModulePayload cmPayload;
         std::vector<uint8_t> vendorData = std::vector<uint8_t>(begin(vendorDataAsString), end(vendorDataAsString));
@@ -58,6 +65,8 @@ protected:
 protected:
     modules::asam_cmp_data_sink_module::DataPacketsPublisher publisher;
     modules::asam_cmp_data_sink_module::CapturePacketsPublisher capturePacketPublisher;
+    modules::asam_cmp_data_sink_module::SequenceTracker sequenceTracker;
+    modules::asam_cmp_data_sink_module::LatencyProbeTracker latencyProbeTracker;
     ContextPtr context;
     FunctionBlockPtr funcBlock;
     FunctionBlockPtr statusFb;
@@ -217,3 +226,58 @@ TEST_F(DataSinkFbTest, DefaultDevicesIds)
     const Int id2 = captureFb2.getPropertyValue("DeviceId");
     ASSERT_EQ(id1, id2);
 }
+
+TEST_F(DataSinkFbTest, AutoSync)
+{
+    auto setStreams = [this](uint32_t interfaceId, std::vector<uint8_t> streams)
+    {
+        InterfacePayload ifPayload;
+        ifPayload.setInterfaceId(interfaceId);
+        ifPayload.setInterfaceType(1);
+        ifPayload.setData(streams.data(), static_cast<uint16_t>(streams.size()), nullptr, 0);
+        ifPacket->setPayload(ifPayload);
+        statusHandler->processStatusPacket(ifPacket);
+        funcBlock.asPtr<IStatusListener>(true)->statusChanged();
+    };
+    auto contains = [](const FunctionBlockPtr& parent, const FunctionBlockPtr& child)
+    {
+        for (const auto& fb : parent.getFunctionBlocks())
+            if (fb == child)
+                return true;
+        return false;
+    };
+
+    statusHandler->processStatusPacket(cmPacket);
+    statusHandler->processStatusPacket(ifPacket);
+    funcBlock.asPtr<IStatusListener>(true)->statusChanged();
+    ASSERT_EQ(funcBlock.getFunctionBlocks().getCount(), 0u);
+
+    funcBlock.setPropertyValue("AutoSync", true);
+    ASSERT_EQ(funcBlock.getFunctionBlocks().getCount(), 1u);
+    const auto captureFb = funcBlock.getFunctionBlocks()[0];
+    ASSERT_EQ(captureFb.getFunctionBlocks().getCount(), 1u);
+    const auto interfaceFb = captureFb.getFunctionBlocks()[0];
+    ASSERT_EQ(interfaceFb.getFunctionBlocks().getCount(), 1u);
+    const auto firstStreamFb = interfaceFb.getFunctionBlocks()[0];
+    ASSERT_EQ(publisher.size(), 1u);
+
+    setStreams(0, {1, 2});
+    ASSERT_EQ(funcBlock.getFunctionBlocks().getCount(), 1u);
+    ASSERT_EQ(captureFb.getFunctionBlocks().getCount(), 1u);
+    ASSERT_TRUE(contains(captureFb, interfaceFb));
+    ASSERT_EQ(interfaceFb.getFunctionBlocks().getCount(), 2u);
+    ASSERT_TRUE(contains(interfaceFb, firstStreamFb));
+    ASSERT_EQ(publisher.size(), 2u);
+
+    setStreams(0, {2});
+    ASSERT_EQ(interfaceFb.getFunctionBlocks().getCount(), 1u);
+    ASSERT_FALSE(contains(interfaceFb, firstStreamFb));
+    const Int streamId = interfaceFb.getFunctionBlocks()[0].getPropertyValue("StreamId");
+    ASSERT_EQ(streamId, 2);
+    ASSERT_EQ(publisher.size(), 1u);
+
+    setStreams(4, {1});
+    ASSERT_EQ(captureFb.getFunctionBlocks().getCount(), 2u);
+    ASSERT_TRUE(contains(captureFb, interfaceFb));
+    ASSERT_EQ(publisher.size(), 2u);
+}
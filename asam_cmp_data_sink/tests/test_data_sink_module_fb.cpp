@@ -1,15 +1,23 @@
 #include <EthLayer.h>
 #include <PayloadLayer.h>
+#include <asam_cmp/capture_module_payload.h>
+#include <asam_cmp/cmp_header.h>
+#include <asam_cmp/encoder.h>
+#include <chrono>
+#include <filesystem>
 #include <gtest/gtest.h>
 #include <opendaq/context_factory.h>
 #include <opendaq/packet_factory.h>
 #include <opendaq/reader_factory.h>
 #include <opendaq/scheduler_factory.h>
+#include <thread>
 
 #include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp_common_lib/latency_probe.h>
 #include <asam_cmp_common_lib/network_manager_fb.h>
 #include <asam_cmp_data_sink/data_sink_module_fb.h>
 #include <asam_cmp_data_sink/module_dll.h>
+#include <asam_cmp_data_sink/status_cache.h>
 
 using namespace daq;
 using daq::asam_cmp_common_lib::PcppPacketReceivedCallbackType;
@@ -39,12 +47,14 @@ protected:
 
         ON_CALL(*ethernetWrapper, startCapture(_)).WillByDefault(startStub);
         ON_CALL(*ethernetWrapper, stopCapture()).WillByDefault(stopStub);
+        ON_CALL(*ethernetWrapper, setCaptureFilter(_)).WillByDefault(Return(true));
+        ON_CALL(*ethernetWrapper, setCaptureConfiguration(_)).WillByDefault(Return(true));
         ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(names));
         ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
 
         EXPECT_CALL(*ethernetWrapper, startCapture(_)).Times(AtLeast(1));
         EXPECT_CALL(*ethernetWrapper, stopCapture()).Times(AtLeast(1));
-        EXPECT_CALL(*ethernetWrapper, setDevice(_)).Times(AtLeast(1)).WillRepeatedly(Return(true));
+        EXPECT_CALL(*ethernetWrapper, setDevice(_)).Times(0);
         EXPECT_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).Times(AtLeast(1));
         EXPECT_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).Times(AtLeast(1));
 
@@ -103,14 +113,37 @@ TEST_F(DataSinkModuleFbTest, NetworkAdaptersProperties)
     int newVal = 0;
     if (propList.getCount() > 0)
         newVal = 1;
+    EXPECT_CALL(*ethernetWrapper, setDevice(_)).WillOnce(Return(true));
     testProperty(networkAdapters.data(), newVal);
 }
 
+TEST_F(DataSinkModuleFbTest, NetworkAdaptersFollowActiveAdapter)
+{
+    // The wrapper fell through to the second adapter because the first one couldn't be opened
+    ON_CALL(*ethernetWrapper, getActiveDeviceName()).WillByDefault(Return(String("name2")));
+    ASSERT_EQ(funcBlock.getPropertyValue("NetworkAdapters"), 1);
+}
+
 TEST_F(DataSinkModuleFbTest, NestedFbCount)
 {
     EXPECT_EQ(funcBlock.getFunctionBlocks().getCount(), 2u);
 }
 
+TEST_F(DataSinkModuleFbTest, CaptureFilterFollowsSubscriptions)
+{
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    auto captureFb = dataSinkFb.getFunctionBlocks().getItemAt(0);
+    captureFb.getPropertyValue("AddInterface").execute();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+
+    EXPECT_CALL(*ethernetWrapper, setCaptureFilter(HasSubstr("ether[30:4] == 1"))).Times(1);
+    interfaceFb.getPropertyValue("AddStream").execute();
+
+    EXPECT_CALL(*ethernetWrapper, setCaptureFilter("ether[18] == 3 or ether[18] == 255")).Times(1);
+    interfaceFb.getPropertyValue("RemoveStream").execute(0);
+}
+
 TEST_F(DataSinkModuleFbTest, ProcessAggregatedMessage)
 {
     constexpr uint16_t asamCmpEtherType = 0x99FE;
@@ -171,3 +204,138 @@ TEST_F(DataSinkModuleFbTest, ProcessAggregatedMessage)
     const size_t sampleCount = dataPacket.getSampleCount();
     ASSERT_EQ(sampleCount, messagesCount);
 }
+
+TEST_F(DataSinkModuleFbTest, ProcessLatencyProbe)
+{
+    constexpr uint16_t asamCmpEtherType = 0x99FE;
+    constexpr uint16_t deviceId = 7;
+
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    auto captureFb = dataSinkFb.getFunctionBlocks().getItemAt(0);
+    captureFb.setPropertyValue("DeviceId", deviceId);
+
+    const auto txTime = std::chrono::system_clock::now() - std::chrono::milliseconds(1);
+    const auto txTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(txTime.time_since_epoch()).count();
+    const auto probeData = asam_cmp_common_lib::encodeLatencyProbe({deviceId, 0, static_cast<uint64_t>(txTimeNs)});
+
+    pcpp::EthLayer newEthernetLayer(pcpp::MacAddress("00:50:43:11:22:33"), pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), asamCmpEtherType);
+    pcpp::PayloadLayer payloadLayer(probeData.data(), probeData.size());
+    pcpp::Packet newPacket;
+    newPacket.addLayer(&newEthernetLayer);
+    newPacket.addLayer(&payloadLayer);
+    newPacket.computeCalculateFields();
+
+    packetReceivedCallback(newPacket.getRawPacket(), nullptr, nullptr);
+
+    ASSERT_EQ(captureFb.getPropertyValue("LatencyProbesReceived"), 1);
+    ASSERT_EQ(captureFb.getPropertyValue("ReceivedMessages"), 0);
+    ASSERT_GT(static_cast<Int>(captureFb.getPropertyValue("ProbeTransportLatencyP50")), 0);
+    ASSERT_GE(static_cast<Int>(captureFb.getPropertyValue("ProbeProcessingLatencyP50")), 1'000'000);
+}
+
+TEST_F(DataSinkModuleFbTest, CaptureStatistics)
+{
+    asam_cmp_common_lib::CaptureStatistics statistics;
+    statistics.received = 100;
+    statistics.droppedByKernel = 3;
+    statistics.droppedByInterface = 1;
+    EXPECT_CALL(*ethernetWrapper, getCaptureStatistics()).Times(AtLeast(3)).WillRepeatedly(Return(statistics));
+
+    ASSERT_EQ(funcBlock.getPropertyValue("ReceivedFrames"), 100);
+    ASSERT_EQ(funcBlock.getPropertyValue("DroppedByKernel"), 3);
+    ASSERT_EQ(funcBlock.getPropertyValue("DroppedByInterface"), 1);
+    EXPECT_THROW(funcBlock.setPropertyValue("DroppedByKernel", 0), daq::AccessDeniedException);
+}
+
+TEST_F(DataSinkModuleFbTest, CaptureConfiguration)
+{
+    constexpr int bufferSize = 16 * 1024 * 1024;
+    EXPECT_CALL(*ethernetWrapper, setCaptureConfiguration(Field(&asam_cmp_common_lib::CaptureConfiguration::bufferSize, bufferSize)))
+        .Times(1);
+    funcBlock.setPropertyValue("CaptureBufferSize", bufferSize);
+
+    EXPECT_CALL(*ethernetWrapper,
+                setCaptureConfiguration(AllOf(Field(&asam_cmp_common_lib::CaptureConfiguration::bufferSize, bufferSize),
+                                              Field(&asam_cmp_common_lib::CaptureConfiguration::immediateMode, false))))
+        .Times(1);
+    funcBlock.setPropertyValue("ImmediateMode", false);
+
+    EXPECT_CALL(*ethernetWrapper, setCaptureConfiguration(Field(&asam_cmp_common_lib::CaptureConfiguration::suppressLocalFrames, true)))
+        .Times(1);
+    funcBlock.setPropertyValue("SuppressLocalFrames", true);
+}
+
+TEST_F(DataSinkModuleFbTest, BatchCaptureMode)
+{
+    asam_cmp_common_lib::PcppPacketsReceivedCallbackType packetsReceivedCallback;
+    EXPECT_CALL(*ethernetWrapper, startBatchCapture(_))
+        .Times(1)
+        .WillOnce([&packetsReceivedCallback](asam_cmp_common_lib::PcppPacketsReceivedCallbackType callback)
+                  { packetsReceivedCallback = callback; });
+    funcBlock.setPropertyValue("CaptureMode", 1);
+    ASSERT_TRUE(packetsReceivedCallback);
+
+    EXPECT_CALL(*ethernetWrapper, startCapture(_)).Times(1);
+    funcBlock.setPropertyValue("CaptureMode", 0);
+}
+
+TEST_F(DataSinkModuleFbTest, StatusCacheRestoresStatus)
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    const modules::asam_cmp_data_sink_module::StatusCache cache(directory, names[0].toStdString());
+
+    ASAM::CMP::CaptureModulePayload payload;
+    payload.setData("Cached device", "", "", "", {});
+    ASAM::CMP::Packet packet;
+    packet.setPayload(payload);
+    packet.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+    packet.setDeviceId(12);
+    ASAM::CMP::Status status;
+    status.update(packet);
+    cache.save(status);
+
+    funcBlock.setPropertyValue("StatusCacheDirectory", directory.string());
+    funcBlock.setPropertyValue("StatusCache", true);
+    std::filesystem::remove(cache.getFilePath());
+
+    auto statusFb = funcBlock.getFunctionBlocks().getItemAt(0);
+    ListPtr<IString> captureModules = statusFb.getPropertyValue("CaptureModuleList");
+    ASSERT_EQ(captureModules.getCount(), 1u);
+    ASSERT_EQ(captureModules[0], "Id: 12, Name: Cached device, Interfaces: 0");
+}
+
+TEST_F(DataSinkModuleFbTest, AutoSyncOffCaptureThread)
+{
+    constexpr uint16_t asamCmpEtherType = 0x99FE;
+    constexpr uint16_t deviceId = 5;
+
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.setPropertyValue("AutoSync", true);
+
+    ASAM::CMP::CaptureModulePayload payload;
+    payload.setData("Device", "", "", "", {});
+    ASAM::CMP::Packet statusPacket;
+    statusPacket.setPayload(payload);
+    statusPacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+
+    ASAM::CMP::Encoder encoder;
+    encoder.setDeviceId(deviceId);
+    const auto cmpFrame = encoder.encode(statusPacket, ASAM::CMP::DataContext{64, 1500}).front();
+
+    pcpp::EthLayer newEthernetLayer(pcpp::MacAddress("00:50:43:11:22:33"), pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), asamCmpEtherType);
+    pcpp::PayloadLayer payloadLayer(cmpFrame.data(), cmpFrame.size());
+    pcpp::Packet newPacket;
+    newPacket.addLayer(&newEthernetLayer);
+    newPacket.addLayer(&payloadLayer);
+    newPacket.computeCalculateFields();
+
+    packetReceivedCallback(newPacket.getRawPacket(), nullptr, nullptr);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (dataSinkFb.getFunctionBlocks().getCount() == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_EQ(dataSinkFb.getFunctionBlocks().getCount(), 1u);
+    ASSERT_EQ(static_cast<Int>(dataSinkFb.getFunctionBlocks()[0].getPropertyValue("DeviceId")), deviceId);
+}
@@ -0,0 +1,203 @@
+#include <RawPacket.h>
+#include <asam_cmp/can_payload.h>
+#include <asam_cmp/encoder.h>
+#include <gmock/gmock.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <array>
+#include <numeric>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp_data_sink/asam_cmp_packets_subscriber.h>
+#include <asam_cmp_data_sink/capture_fb.h>
+#include <asam_cmp_data_sink/capture_packets_publisher.h>
+#include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/data_sink_module_fb.h>
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+#include <asam_cmp_data_sink/sequence_tracker.h>
+#include <allocation_counter.h>
+
+using namespace daq;
+using namespace testing;
+using ASAM::CMP::CanPayload;
+using ASAM::CMP::Packet;
+using daq::asam_cmp_common_lib::EthernetPcppMock;
+using daq::asam_cmp_common_lib::PcppPacketReceivedCallbackType;
+using daq::modules::asam_cmp_data_sink_module::CapturePacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::DataPacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+using daq::modules::asam_cmp_data_sink_module::LatencyProbeTracker;
+using daq::modules::asam_cmp_data_sink_module::SequenceTracker;
+
+class HotPathAllocationsTest : public testing::Test
+{
+protected:
+    static std::vector<std::shared_ptr<Packet>> createCanPackets(size_t messagesCount)
+    {
+        std::array<uint8_t, 8> data;
+        std::iota(data.begin(), data.end(), uint8_t{0});
+
+        std::vector<std::shared_ptr<Packet>> packets;
+        for (size_t i = 0; i < messagesCount; ++i)
+        {
+            CanPayload payload;
+            payload.setData(data.data(), data.size());
+            payload.setId(static_cast<uint32_t>(i % 0x800));
+
+            auto& packet = packets.emplace_back(std::make_shared<Packet>());
+            packet->setPayload(payload);
+            packet->setTimestamp(i * 100000);
+            packet->setDeviceId(deviceId);
+            packet->setInterfaceId(interfaceId);
+            packet->setStreamId(streamId);
+        }
+
+        return packets;
+    }
+
+    // Builds Ethernet frames carrying exactly messagesPerFrame aggregated CAN messages each
+    static std::vector<std::vector<uint8_t>> createFrames(size_t messagesPerFrame, size_t framesCount)
+    {
+        ASAM::CMP::Encoder encoder;
+        encoder.setDeviceId(deviceId);
+        encoder.setStreamId(streamId);
+
+        std::vector<Packet> packets;
+        for (const auto& packet : createCanPackets(messagesPerFrame * framesCount))
+            packets.push_back(*packet);
+
+        const ASAM::CMP::DataContext dataContext{64, 1500};
+        const std::array<uint8_t, ethHeaderSize> ethHeader{
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x50, 0x43, 0x11, 0x22, 0x33, 0x99, 0xFE};
+
+        std::vector<std::vector<uint8_t>> frames;
+        for (auto chunk = packets.begin(); chunk != packets.end(); chunk += messagesPerFrame)
+        {
+            for (auto& cmpFrame : encoder.encode(chunk, chunk + messagesPerFrame, dataContext))
+            {
+                auto& frame = frames.emplace_back(ethHeader.begin(), ethHeader.end());
+                frame.insert(frame.end(), cmpFrame.begin(), cmpFrame.end());
+            }
+        }
+
+        return frames;
+    }
+
+protected:
+    static constexpr uint16_t deviceId = 1;
+    static constexpr uint32_t interfaceId = 2;
+    static constexpr uint8_t streamId = 3;
+    static constexpr int canPayloadType = 1;
+    static constexpr size_t ethHeaderSize = 14;
+};
+
+TEST_F(HotPathAllocationsTest, StreamFbReceiveCan)
+{
+    SKIP_IF_ALLOCATIONS_NOT_COUNTED();
+
+    DataPacketsPublisher publisher;
+    CapturePacketsPublisher capturePacketsPublisher;
+    SequenceTracker sequenceTracker;
+    LatencyProbeTracker latencyProbeTracker;
+
+    auto logger = Logger();
+    auto captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::CaptureFb>(
+        Context(Scheduler(logger), logger, TypeManager(), nullptr),
+        nullptr,
+        "capture_module_0",
+        publisher,
+        capturePacketsPublisher,
+        sequenceTracker,
+        latencyProbeTracker);
+
+    captureFb.getPropertyValue("AddInterface").execute();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    interfaceFb.getPropertyValue("AddStream").execute();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+    captureFb.setPropertyValue("DeviceId", deviceId);
+    interfaceFb.setPropertyValue("InterfaceId", interfaceId);
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    streamFb.setPropertyValue("StreamId", static_cast<Int>(streamId));
+
+    auto subscriber = streamFb.as<IAsamCmpPacketsSubscriber>(true);
+
+    constexpr size_t messagesPerBatch = 32;
+    constexpr size_t warmUpBatches = 10;
+    constexpr size_t batchesCount = 1000;
+    const auto packets = createCanPackets(messagesPerBatch);
+
+    for (size_t i = 0; i < warmUpBatches; ++i)
+        subscriber->receive(packets);
+
+    AllocationStatistics statistics;
+    {
+        AllocationCounter counter;
+        for (size_t i = 0; i < batchesCount; ++i)
+            subscriber->receive(packets);
+        statistics = counter.getStatistics();
+    }
+
+    expectAllocationBudget(statistics, batchesCount * messagesPerBatch, 2, 512);
+}
+
+TEST_F(HotPathAllocationsTest, DataSinkModuleFbOnPacketArrives)
+{
+    SKIP_IF_ALLOCATIONS_NOT_COUNTED();
+
+    auto ethernetWrapper = std::make_shared<NiceMock<EthernetPcppMock>>();
+
+    ListPtr<StringPtr> names{"name1"};
+    ListPtr<StringPtr> descriptions{"desc1"};
+    PcppPacketReceivedCallbackType packetReceivedCallback;
+
+    ON_CALL(*ethernetWrapper, startCapture(_))
+        .WillByDefault([&packetReceivedCallback](PcppPacketReceivedCallbackType callback) { packetReceivedCallback = callback; });
+    ON_CALL(*ethernetWrapper, setDevice(_)).WillByDefault(Return(true));
+    ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(names));
+    ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
+
+    auto logger = Logger();
+    auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr);
+    auto funcBlock = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::DataSinkModuleFb>(
+        context, nullptr, "id", ethernetWrapper);
+    ASSERT_TRUE(packetReceivedCallback);
+
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    auto captureFb = dataSinkFb.getFunctionBlocks().getItemAt(0);
+    captureFb.setPropertyValue("DeviceId", deviceId);
+    captureFb.getPropertyValue("AddInterface").execute();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    interfaceFb.setPropertyValue("InterfaceId", interfaceId);
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    interfaceFb.getPropertyValue("AddStream").execute();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    streamFb.setPropertyValue("StreamId", static_cast<Int>(streamId));
+
+    constexpr size_t messagesPerFrame = 32;
+    constexpr size_t warmUpFrames = 10;
+    constexpr size_t framesCount = 1000;
+    auto frames = createFrames(messagesPerFrame, warmUpFrames + framesCount);
+
+    timeval timestamp{};
+    std::vector<std::unique_ptr<pcpp::RawPacket>> rawPackets;
+    for (auto& frame : frames)
+        rawPackets.push_back(
+            std::make_unique<pcpp::RawPacket>(frame.data(), static_cast<int>(frame.size()), timestamp, false, pcpp::LINKTYPE_ETHERNET));
+    ASSERT_EQ(rawPackets.size(), warmUpFrames + framesCount);
+
+    for (size_t i = 0; i < warmUpFrames; ++i)
+        packetReceivedCallback(rawPackets[i].get(), nullptr, nullptr);
+
+    AllocationStatistics statistics;
+    {
+        AllocationCounter counter;
+        for (size_t i = warmUpFrames; i < rawPackets.size(); ++i)
+            packetReceivedCallback(rawPackets[i].get(), nullptr, nullptr);
+        statistics = counter.getStatistics();
+    }
+
+    // Decoding still creates an ASAM CMP packet and payload per message; the budget catches anything added on top
+    expectAllocationBudget(statistics, framesCount * messagesPerFrame, 8, 1024);
+}
@@ -19,7 +19,13 @@ protected:
     {
         auto logger = Logger();
         captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::CaptureFb>(
-            Context(Scheduler(logger), logger, TypeManager(), nullptr), nullptr, "capture_module_0", publisher, capturePacketsPublisher);
+            Context(Scheduler(logger), logger, TypeManager(), nullptr),
+            nullptr,
+            "capture_module_0",
+            publisher,
+            capturePacketsPublisher,
+            sequenceTracker,
+            latencyProbeTracker);
 
         captureFb.getPropertyValue("AddInterface").execute();
         interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
@@ -30,6 +36,8 @@ protected:
     FunctionBlockPtr interfaceFb;
     modules::asam_cmp_data_sink_module::DataPacketsPublisher publisher;
     modules::asam_cmp_data_sink_module::CapturePacketsPublisher capturePacketsPublisher;
+    modules::asam_cmp_data_sink_module::SequenceTracker sequenceTracker;
+    modules::asam_cmp_data_sink_module::LatencyProbeTracker latencyProbeTracker;
 };
 
 TEST_F(InterfaceFbTest, NotNull)
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/latency_probe_tracker.h>
+
+using daq::modules::asam_cmp_data_sink_module::LatencyProbeTracker;
+
+class LatencyProbeTrackerTest : public ::testing::Test
+{
+protected:
+    static constexpr uint16_t deviceId = 3;
+
+protected:
+    LatencyProbeTracker tracker;
+};
+
+TEST_F(LatencyProbeTrackerTest, UnknownDevice)
+{
+    auto statistics = tracker.getStatistics(deviceId);
+    ASSERT_EQ(statistics.received, 0u);
+    ASSERT_EQ(statistics.transportP50, 0);
+    ASSERT_EQ(statistics.processingMax, 0);
+}
+
+TEST_F(LatencyProbeTrackerTest, Percentiles)
+{
+    for (int64_t latency = 100; latency >= 1; --latency)
+        tracker.record(deviceId, latency, latency * 10);
+
+    auto statistics = tracker.getStatistics(deviceId);
+    ASSERT_EQ(statistics.received, 100u);
+    ASSERT_EQ(statistics.transportP50, 51);
+    ASSERT_EQ(statistics.transportP99, 100);
+    ASSERT_EQ(statistics.transportMax, 100);
+    ASSERT_EQ(statistics.processingP50, 510);
+    ASSERT_EQ(statistics.processingMax, 1000);
+}
+
+TEST_F(LatencyProbeTrackerTest, NegativeTransportLatency)
+{
+    tracker.record(deviceId, -500, 100);
+
+    auto statistics = tracker.getStatistics(deviceId);
+    ASSERT_EQ(statistics.transportP50, -500);
+    ASSERT_EQ(statistics.transportMax, -500);
+}
+
+TEST_F(LatencyProbeTrackerTest, RollingWindow)
+{
+    for (size_t i = 0; i < LatencyProbeTracker::windowSize; ++i)
+        tracker.record(deviceId, 1'000'000, 1'000'000);
+    for (size_t i = 0; i < LatencyProbeTracker::windowSize; ++i)
+        tracker.record(deviceId, 10, 20);
+
+    auto statistics = tracker.getStatistics(deviceId);
+    ASSERT_EQ(statistics.received, 2 * LatencyProbeTracker::windowSize);
+    ASSERT_EQ(statistics.transportMax, 10);
+    ASSERT_EQ(statistics.processingMax, 20);
+}
+
+TEST_F(LatencyProbeTrackerTest, DevicesAreIndependent)
+{
+    tracker.record(deviceId, 10, 10);
+    tracker.record(deviceId + 1, 20, 20);
+
+    ASSERT_EQ(tracker.getStatistics(deviceId).transportMax, 10);
+    ASSERT_EQ(tracker.getStatistics(deviceId + 1).transportMax, 20);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/packet_buffer_pool.h>
+
+using daq::modules::asam_cmp_data_sink_module::PacketBufferPool;
+
+TEST(PacketBufferPoolTest, ReuseReleasedBuffer)
+{
+    PacketBufferPool pool;
+
+    auto buffer = pool.allocate(100);
+    ASSERT_NE(buffer, nullptr);
+    pool.release(buffer);
+    ASSERT_EQ(pool.getCachedBuffersCount(), 1u);
+
+    auto reused = pool.allocate(120);
+    ASSERT_EQ(reused, buffer);
+    ASSERT_EQ(pool.getCachedBuffersCount(), 0u);
+    pool.release(reused);
+}
+
+TEST(PacketBufferPoolTest, DifferentSizeClasses)
+{
+    PacketBufferPool pool;
+
+    auto buffer = pool.allocate(PacketBufferPool::minBufferSize);
+    pool.release(buffer);
+
+    auto bigger = pool.allocate(PacketBufferPool::minBufferSize + 1);
+    ASSERT_NE(bigger, buffer);
+    ASSERT_EQ(pool.getCachedBuffersCount(), 1u);
+    pool.release(bigger);
+    ASSERT_EQ(pool.getCachedBuffersCount(), 2u);
+}
+
+TEST(PacketBufferPoolTest, HugeBuffersAreNotCached)
+{
+    PacketBufferPool pool;
+
+    auto buffer = pool.allocate(PacketBufferPool::minBufferSize << PacketBufferPool::sizeClassesCount);
+    ASSERT_NE(buffer, nullptr);
+    pool.release(buffer);
+    ASSERT_EQ(pool.getCachedBuffersCount(), 0u);
+}
+
+TEST(PacketBufferPoolTest, CachedBuffersAreLimited)
+{
+    PacketBufferPool pool;
+
+    std::vector<void*> buffers;
+    for (size_t i = 0; i < PacketBufferPool::maxCachedBuffersPerClass + 1; ++i)
+        buffers.push_back(pool.allocate(10));
+    for (auto buffer : buffers)
+        pool.release(buffer);
+
+    ASSERT_EQ(pool.getCachedBuffersCount(), PacketBufferPool::maxCachedBuffersPerClass);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/sequence_tracker.h>
+
+using daq::modules::asam_cmp_data_sink_module::SequenceTracker;
+
+class SequenceTrackerTest : public ::testing::Test
+{
+protected:
+    static constexpr uint16_t deviceId = 3;
+    static constexpr uint8_t streamId = 7;
+
+protected:
+    SequenceTracker tracker;
+};
+
+TEST_F(SequenceTrackerTest, UnknownStream)
+{
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 0u);
+    ASSERT_EQ(statistics.lost, 0u);
+    ASSERT_EQ(statistics.lossRate, 0.0);
+}
+
+TEST_F(SequenceTrackerTest, ContinuousSequence)
+{
+    for (uint16_t i = 0; i < 10; ++i)
+        tracker.track(deviceId, streamId, i);
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 10u);
+    ASSERT_EQ(statistics.lost, 0u);
+    ASSERT_EQ(statistics.duplicated, 0u);
+    ASSERT_EQ(statistics.reordered, 0u);
+}
+
+TEST_F(SequenceTrackerTest, SequenceCounterWrapAround)
+{
+    tracker.track(deviceId, streamId, 0xFFFE);
+    tracker.track(deviceId, streamId, 0xFFFF);
+    tracker.track(deviceId, streamId, 0);
+    tracker.track(deviceId, streamId, 1);
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 4u);
+    ASSERT_EQ(statistics.lost, 0u);
+}
+
+TEST_F(SequenceTrackerTest, LostMessages)
+{
+    tracker.track(deviceId, streamId, 10);
+    tracker.track(deviceId, streamId, 11);
+    tracker.track(deviceId, streamId, 15);
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 3u);
+    ASSERT_EQ(statistics.lost, 3u);
+}
+
+TEST_F(SequenceTrackerTest, DuplicatedMessage)
+{
+    tracker.track(deviceId, streamId, 1);
+    tracker.track(deviceId, streamId, 1);
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 2u);
+    ASSERT_EQ(statistics.duplicated, 1u);
+    ASSERT_EQ(statistics.lost, 0u);
+}
+
+TEST_F(SequenceTrackerTest, ReorderedMessage)
+{
+    tracker.track(deviceId, streamId, 1);
+    tracker.track(deviceId, streamId, 3);
+    tracker.track(deviceId, streamId, 2);
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 3u);
+    ASSERT_EQ(statistics.reordered, 1u);
+    ASSERT_EQ(statistics.lost, 0u);
+}
+
+TEST_F(SequenceTrackerTest, SenderRestart)
+{
+    tracker.track(deviceId, streamId, 1000);
+    tracker.track(deviceId, streamId, 0);
+    tracker.track(deviceId, streamId, 1);
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 3u);
+    ASSERT_EQ(statistics.lost, 0u);
+    ASSERT_EQ(statistics.reordered, 0u);
+}
+
+TEST_F(SequenceTrackerTest, LossRate)
+{
+    uint16_t sequenceCounter = 0;
+    for (uint64_t i = 0; i < SequenceTracker::lossRateWindow; i += 2)
+    {
+        tracker.track(deviceId, streamId, sequenceCounter);
+        sequenceCounter += 2;
+    }
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_NEAR(statistics.lossRate, 0.5, 0.01);
+}
+
+TEST_F(SequenceTrackerTest, RawCmpHeader)
+{
+    std::vector<uint8_t> header = {1, 0, 0, deviceId, 1, streamId, 0x12, 0x34};
+    tracker.track(header.data(), header.size());
+    header[7] = 0x36;
+    tracker.track(header.data(), header.size());
+
+    auto statistics = tracker.getStatistics(deviceId, streamId);
+    ASSERT_EQ(statistics.received, 2u);
+    ASSERT_EQ(statistics.lost, 1u);
+
+    tracker.track(header.data(), header.size() - 1);
+    ASSERT_EQ(tracker.getStatistics(deviceId, streamId).received, 2u);
+}
+
+TEST_F(SequenceTrackerTest, DeviceStatistics)
+{
+    tracker.track(deviceId, 1, 0);
+    tracker.track(deviceId, 1, 2);
+    tracker.track(deviceId, 2, 0);
+    tracker.track(deviceId + 1, 1, 0);
+
+    auto statistics = tracker.getStatistics(deviceId);
+    ASSERT_EQ(statistics.received, 3u);
+    ASSERT_EQ(statistics.lost, 1u);
+}
+
+TEST_F(SequenceTrackerTest, StatusMessagesAreIgnored)
+{
+    std::vector<uint8_t> header = {1, 0, 0, deviceId, 3, streamId, 0x12, 0x34};
+    tracker.track(header.data(), header.size());
+
+    ASSERT_EQ(tracker.getStatistics(deviceId, streamId).received, 0u);
+}
+
+TEST_F(SequenceTrackerTest, LossTrackedStreams)
+{
+    tracker.setLossTrackedStreams({{deviceId, 1}});
+
+    tracker.track(deviceId, 1, 0);
+    tracker.track(deviceId, 1, 2);
+    tracker.track(deviceId, streamId, 0);
+    tracker.track(deviceId, streamId, 2);
+    ASSERT_EQ(tracker.getStatistics(deviceId, 1).lost, 1u);
+    ASSERT_EQ(tracker.getStatistics(deviceId, streamId).lost, 0u);
+    ASSERT_EQ(tracker.getStatistics(deviceId, streamId).received, 2u);
+
+    // Tracking starts over from the next message, the gap while the stream was not tracked is no loss
+    tracker.setLossTrackedStreams({{deviceId, streamId}});
+    tracker.track(deviceId, streamId, 10);
+    tracker.track(deviceId, streamId, 11);
+    tracker.track(deviceId, 1, 10);
+    ASSERT_EQ(tracker.getStatistics(deviceId, streamId).lost, 0u);
+    ASSERT_EQ(tracker.getStatistics(deviceId, 1).lost, 1u);
+}
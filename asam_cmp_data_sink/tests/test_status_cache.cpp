@@ -0,0 +1,114 @@
+#include <asam_cmp/capture_module_payload.h>
+#include <asam_cmp/cmp_header.h>
+#include <asam_cmp/interface_payload.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+#include <asam_cmp_data_sink/status_cache.h>
+
+using ASAM::CMP::CaptureModulePayload;
+using ASAM::CMP::InterfacePayload;
+using ASAM::CMP::Packet;
+using daq::modules::asam_cmp_data_sink_module::StatusCache;
+
+class StatusCacheTest : public ::testing::Test
+{
+protected:
+    StatusCacheTest()
+        : cache(std::filesystem::temp_directory_path(), "\\Device\\NPF_{test}")
+    {
+        std::filesystem::remove(cache.getFilePath());
+
+        CaptureModulePayload cmPayload;
+        cmPayload.setData(deviceDescr, "Serial", "HW", "SW", {});
+        Packet cmPacket;
+        cmPacket.setPayload(cmPayload);
+        cmPacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+        cmPacket.setDeviceId(deviceId);
+        status.update(cmPacket);
+
+        InterfacePayload ifPayload;
+        ifPayload.setInterfaceId(interfaceId);
+        ifPayload.setData(streams.data(), static_cast<uint16_t>(streams.size()), nullptr, 0);
+        Packet ifPacket;
+        ifPacket.setPayload(ifPayload);
+        ifPacket.getPayload().setMessageType(ASAM::CMP::CmpHeader::MessageType::status);
+        ifPacket.setDeviceId(deviceId);
+        status.update(ifPacket);
+    }
+
+    ~StatusCacheTest() override
+    {
+        std::filesystem::remove(cache.getFilePath());
+    }
+
+protected:
+    StatusCache cache;
+    ASAM::CMP::Status status;
+
+    const uint16_t deviceId = 3;
+    const uint32_t interfaceId = 7;
+    const std::string_view deviceDescr = "Device 3";
+    const std::vector<uint8_t> streams = {1, 4, 5};
+};
+
+TEST_F(StatusCacheTest, FileNameIsKeyedByAdapter)
+{
+    const auto fileName = cache.getFilePath().filename().string();
+    ASSERT_EQ(fileName.find_first_of("\\{}"), std::string::npos);
+
+    StatusCache otherCache(std::filesystem::temp_directory_path(), "eth1");
+    ASSERT_NE(otherCache.getFilePath(), cache.getFilePath());
+    ASSERT_EQ(otherCache.getAdapterName(), "eth1");
+}
+
+TEST_F(StatusCacheTest, NothingCached)
+{
+    ASSERT_TRUE(cache.load().empty());
+}
+
+TEST_F(StatusCacheTest, SaveAndLoad)
+{
+    cache.save(status);
+
+    ASAM::CMP::Status restoredStatus;
+    for (const auto& packet : cache.load())
+        restoredStatus.update(*packet);
+
+    ASSERT_EQ(restoredStatus.getDeviceStatusCount(), 1u);
+    const auto& deviceStatus = restoredStatus.getDeviceStatus(0);
+    ASSERT_EQ(deviceStatus.getPacket().getDeviceId(), deviceId);
+    ASSERT_EQ(static_cast<const CaptureModulePayload&>(deviceStatus.getPacket().getPayload()).getDeviceDescription(), deviceDescr);
+
+    ASSERT_EQ(deviceStatus.getInterfaceStatusCount(), 1u);
+    const auto& payload = static_cast<const InterfacePayload&>(deviceStatus.getInterfaceStatus(0).getPacket().getPayload());
+    ASSERT_EQ(payload.getInterfaceId(), interfaceId);
+    ASSERT_EQ(payload.getStreamIdsCount(), streams.size());
+    const auto streamIds = payload.getStreamIds();
+    for (size_t i = 0; i < streams.size(); ++i)
+        ASSERT_EQ(streamIds[i], streams[i]);
+}
+
+TEST_F(StatusCacheTest, SaveReplacesPreviousStatus)
+{
+    cache.save(status);
+    cache.save(ASAM::CMP::Status{});
+
+    ASSERT_TRUE(cache.load().empty());
+    ASSERT_FALSE(std::filesystem::exists(cache.getFilePath().string() + ".tmp"));
+}
+
+TEST_F(StatusCacheTest, CorruptedFile)
+{
+    {
+        std::ofstream file(cache.getFilePath(), std::ios::binary);
+        file << "not a status cache";
+    }
+    ASSERT_THROW(cache.load(), std::runtime_error);
+
+    cache.save(status);
+    const auto size = std::filesystem::file_size(cache.getFilePath());
+    std::filesystem::resize_file(cache.getFilePath(), size - 1);
+    ASSERT_THROW(cache.load(), std::runtime_error);
+}
@@ -130,3 +130,54 @@ TEST_F(StatusFbTest, Clear)
     ASSERT_EQ(cmList.getCount(), 0u);
     ASSERT_EQ(statusMt->getStatus().getDeviceStatusCount(), 0u);
 }
+
+TEST_F(StatusFbTest, RepeatedStatusPackets)
+{
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    ListPtr<IString> cmList = funcBlock.getPropertyValue("CaptureModuleList");
+    ASSERT_EQ(cmList.getCount(), 1u);
+    ASSERT_TRUE(checkDescription(cmList[0], deviceDescr, deviceId, 0));
+
+    const std::string_view newDeviceDescr = "Device 3 renamed";
+    cmPayload.setData(newDeviceDescr, "", "", "", {});
+    packet->setPayload(cmPayload);
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    cmList = funcBlock.getPropertyValue("CaptureModuleList");
+    ASSERT_EQ(cmList.getCount(), 1u);
+    ASSERT_TRUE(checkDescription(cmList[0], newDeviceDescr, deviceId, 0));
+
+    packet->setPayload(ifPayload);
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    cmList = funcBlock.getPropertyValue("CaptureModuleList");
+    ASSERT_TRUE(checkDescription(cmList[0], newDeviceDescr, deviceId, 1));
+
+    std::vector<uint8_t> newStreams = {1, 2};
+    ifPayload.setData(newStreams.data(), static_cast<uint16_t>(newStreams.size()), nullptr, 0);
+    packet->setPayload(ifPayload);
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    const auto status = statusMt->getStatus();
+    const auto& interfaceStatus = status.getDeviceStatus(0).getInterfaceStatus(0);
+    ASSERT_EQ(static_cast<const InterfacePayload&>(interfaceStatus.getPacket().getPayload()).getStreamIdsCount(), newStreams.size());
+}
+
+TEST_F(StatusFbTest, SnapshotVersion)
+{
+    const auto initialSnapshot = statusMt->getSnapshot();
+    ASSERT_EQ(initialSnapshot->status.getDeviceStatusCount(), 0u);
+
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    const auto version = statusMt->getVersion();
+    ASSERT_EQ(version, initialSnapshot->version + 1);
+
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    ASSERT_EQ(statusMt->getVersion(), version);
+
+    packet->setDeviceId(deviceId + 1);
+    funcBlock.asPtr<IStatusHandler>(true)->processStatusPacket(packet);
+    ASSERT_EQ(statusMt->getVersion(), version + 1);
+
+    ASSERT_EQ(initialSnapshot->status.getDeviceStatusCount(), 0u);
+    ASSERT_EQ(statusMt->getSnapshot()->status.getDeviceStatusCount(), 2u);
+}
@@ -24,7 +24,10 @@ using ASAM::CMP::CanPayload;
 using ASAM::CMP::Packet;
 using daq::modules::asam_cmp_data_sink_module::CapturePacketsPublisher;
 using daq::modules::asam_cmp_data_sink_module::DataPacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::Endpoint;
 using daq::modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+using daq::modules::asam_cmp_data_sink_module::LatencyProbeTracker;
+using daq::modules::asam_cmp_data_sink_module::SequenceTracker;
 
 size_t waitForSamples(const GenericReaderPtr<IReader>& reader, std::chrono::milliseconds timeout = 100ms)
 {
@@ -53,7 +56,13 @@ protected:
     {
         auto logger = Logger();
         captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::CaptureFb>(
-            Context(Scheduler(logger), logger, TypeManager(), nullptr), nullptr, "capture_module_0", publisher, capturePacketsPublisher);
+            Context(Scheduler(logger), logger, TypeManager(), nullptr),
+            nullptr,
+            "capture_module_0",
+            publisher,
+            capturePacketsPublisher,
+            sequenceTracker,
+            latencyProbeTracker);
 
         captureFb.getPropertyValue("AddInterface").execute();
         interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
@@ -77,6 +86,8 @@ protected:
 protected:
     DataPacketsPublisher publisher;
     CapturePacketsPublisher capturePacketsPublisher;
+    SequenceTracker sequenceTracker;
+    LatencyProbeTracker latencyProbeTracker;
     FunctionBlockPtr captureFb;
     FunctionBlockPtr interfaceFb;
     FunctionBlockPtr funcBlock;
@@ -103,6 +114,45 @@ TEST_F(StreamFbTest, StreamIdProperty)
     ASSERT_EQ(funcBlock.getPropertyValue("StreamId"), newStreamId);
 }
 
+TEST_F(StreamFbTest, SequenceStatistics)
+{
+    sequenceTracker.track(deviceId, streamId, 0);
+    sequenceTracker.track(deviceId, streamId, 2);
+    sequenceTracker.track(deviceId, streamId, 1);
+    sequenceTracker.track(deviceId, streamId, 2);
+    sequenceTracker.track(deviceId, streamId + 1, 10);
+
+    ASSERT_EQ(funcBlock.getPropertyValue("ReceivedMessages"), 4);
+    ASSERT_EQ(funcBlock.getPropertyValue("LostMessages"), 0);
+    ASSERT_EQ(funcBlock.getPropertyValue("ReorderedMessages"), 1);
+    ASSERT_EQ(funcBlock.getPropertyValue("DuplicatedMessages"), 1);
+    ASSERT_EQ(static_cast<Float>(funcBlock.getPropertyValue("LossRate")), 0.0);
+}
+
+TEST_F(StreamFbTest, AnalogPropertiesFollowPayloadType)
+{
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    ASSERT_FALSE(funcBlock.getProperty("AnalogCoalescing").getVisible());
+    ASSERT_FALSE(funcBlock.getProperty("MaxCoalescedSamples").getVisible());
+    ASSERT_FALSE(funcBlock.getProperty("MaxCoalescingLatency").getVisible());
+
+    interfaceFb.setPropertyValue("PayloadType", analogPayloadType);
+    ASSERT_TRUE(funcBlock.getProperty("AnalogCoalescing").getVisible());
+    ASSERT_TRUE(funcBlock.getProperty("MaxCoalescedSamples").getVisible());
+    ASSERT_TRUE(funcBlock.getProperty("MaxCoalescingLatency").getVisible());
+}
+
+TEST_F(StreamFbTest, CanBatchPropertiesFollowPayloadType)
+{
+    interfaceFb.setPropertyValue("PayloadType", analogPayloadType);
+    ASSERT_FALSE(funcBlock.getProperty("CanBatchSize").getVisible());
+    ASSERT_FALSE(funcBlock.getProperty("CanBatchMaxDelay").getVisible());
+
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    ASSERT_TRUE(funcBlock.getProperty("CanBatchSize").getVisible());
+    ASSERT_TRUE(funcBlock.getProperty("CanBatchMaxDelay").getVisible());
+}
+
 TEST_F(StreamFbTest, AllowTheSameStreamIds)
 {
     interfaceFb.getPropertyValue("AddStream").execute();
@@ -352,6 +402,84 @@ TEST_F(StreamFbCanPayloadTest, ReadOutputCanSignal)
     ASSERT_EQ(checkData, canData);
 }
 
+TEST_F(StreamFbCanPayloadTest, ReadCompactCanSignal)
+{
+#pragma pack(push, 1)
+    struct CANClassicData
+    {
+        uint32_t arbId;
+        uint8_t length;
+        uint8_t data[8];
+    };
+#pragma pack(pop)
+
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    funcBlock.setPropertyValue("CompactCanData", true);
+    const auto outputSignal = funcBlock.getSignalsRecursive()[0];
+    ASSERT_EQ(outputSignal.getDescriptor().getSampleSize(), sizeof(CANClassicData));
+
+    const StreamReaderPtr reader = StreamReaderSkipEvents(outputSignal, SampleType::Struct, SampleType::UInt64);
+    publisher.publish({canPacket->getDeviceId(), canPacket->getInterfaceId(), canPacket->getStreamId()}, canPacket);
+    const auto samplesCount = waitForSamples(reader);
+    ASSERT_EQ(samplesCount, 1);
+
+    CANClassicData sample;
+    uint64_t domainSample;
+    size_t count = 1;
+    reader.readWithDomain(&sample, &domainSample, &count);
+    ASSERT_EQ(count, 1);
+    ASSERT_EQ(sample.arbId, arbId);
+    ASSERT_EQ(sample.length, sizeof(canData));
+    uint32_t checkData = *reinterpret_cast<uint32_t*>(sample.data);
+    ASSERT_EQ(checkData, canData);
+}
+
+TEST_F(StreamFbCanPayloadTest, CompactCanDataIgnoredForCanFd)
+{
+    constexpr int canFdPayloadType = 2;
+    interfaceFb.setPropertyValue("PayloadType", canFdPayloadType);
+    funcBlock.setPropertyValue("CompactCanData", true);
+
+    ASSERT_EQ(funcBlock.getSignalsRecursive()[0].getDescriptor().getSampleSize(), sizeof(CANData));
+    ASSERT_FALSE(funcBlock.getProperty("CompactCanData").getVisible());
+
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    ASSERT_TRUE(funcBlock.getProperty("CompactCanData").getVisible());
+}
+
+TEST_F(StreamFbCanPayloadTest, BatchCanMessages)
+{
+    constexpr Int batchSize = 3;
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    funcBlock.setPropertyValue("CanBatchSize", batchSize);
+    funcBlock.setPropertyValue("CanBatchMaxDelay", 10000);
+    const PacketReaderPtr reader = PacketReader(funcBlock.getSignalsRecursive()[0]);
+
+    const Endpoint endpoint{canPacket->getDeviceId(), canPacket->getInterfaceId(), canPacket->getStreamId()};
+    for (Int i = 0; i < batchSize; ++i)
+        publisher.publish(endpoint, canPacket);
+
+    std::vector<SizeT> sampleCounts;
+    for (const auto& packet : reader.readAll())
+    {
+        if (packet.getType() == PacketType::Data)
+            sampleCounts.push_back(packet.asPtr<IDataPacket>().getSampleCount());
+    }
+    ASSERT_EQ(sampleCounts, std::vector<SizeT>{batchSize});
+}
+
+TEST_F(StreamFbCanPayloadTest, FlushCanBatchOnTimer)
+{
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    funcBlock.setPropertyValue("CanBatchSize", 100);
+    funcBlock.setPropertyValue("CanBatchMaxDelay", 5);
+    const StreamReaderPtr reader = StreamReaderSkipEvents(funcBlock.getSignalsRecursive()[0], SampleType::Struct, SampleType::UInt64);
+
+    publisher.publish({canPacket->getDeviceId(), canPacket->getInterfaceId(), canPacket->getStreamId()}, canPacket);
+    const auto samplesCount = waitForSamples(reader, 500ms);
+    ASSERT_EQ(samplesCount, 1);
+}
+
 template <typename AnalogType>
 class StreamFbAnalogPayloadTest : public StreamFbTest
 {
@@ -630,3 +758,62 @@ TYPED_TEST(StreamFbAnalogPayloadTest, PostScalingChanged)
     ASSERT_EQ(descriptor.getPostScaling(), LinearScaling(newSampleScalar, newSampleOffset, rawSampleType));
     ASSERT_EQ(descriptor.getValueRange(), Range(minValue, maxValue));
 }
+
+TYPED_TEST(StreamFbAnalogPayloadTest, CoalesceContiguousMessages)
+{
+    this->interfaceFb.setPropertyValue("PayloadType", this->analogPayloadType);
+    this->funcBlock.setPropertyValue("MaxCoalescedSamples", static_cast<Int>(this->analogDataSize * 2));
+    this->funcBlock.setPropertyValue("MaxCoalescingLatency", 10000);
+    this->funcBlock.setPropertyValue("AnalogCoalescing", true);
+    const auto outputSignal = this->funcBlock.getSignalsRecursive()[0];
+    const PacketReaderPtr reader = PacketReader(outputSignal);
+
+    const Endpoint endpoint{this->analogPacket->getDeviceId(), this->analogPacket->getInterfaceId(), this->analogPacket->getStreamId()};
+    this->publisher.publish(endpoint, this->analogPacket);
+    auto secondPacket = this->template createAnalogPacket<TypeParam>();
+    secondPacket->setTimestamp(this->analogPacket->getTimestamp() + this->analogDataSize * this->deltaT);
+    this->publisher.publish(endpoint, secondPacket);
+
+    std::vector<SizeT> sampleCounts;
+    for (const auto& packet : reader.readAll())
+    {
+        if (packet.getType() == PacketType::Data)
+            sampleCounts.push_back(packet.asPtr<IDataPacket>().getSampleCount());
+    }
+    ASSERT_EQ(sampleCounts, std::vector<SizeT>{this->analogDataSize * 2});
+}
+
+TYPED_TEST(StreamFbAnalogPayloadTest, CoalescingFlushesOnDiscontinuity)
+{
+    this->interfaceFb.setPropertyValue("PayloadType", this->analogPayloadType);
+    this->funcBlock.setPropertyValue("MaxCoalescedSamples", static_cast<Int>(this->analogDataSize * 2));
+    this->funcBlock.setPropertyValue("MaxCoalescingLatency", 10000);
+    this->funcBlock.setPropertyValue("AnalogCoalescing", true);
+    const auto outputSignal = this->funcBlock.getSignalsRecursive()[0];
+    const PacketReaderPtr reader = PacketReader(outputSignal);
+
+    const Endpoint endpoint{this->analogPacket->getDeviceId(), this->analogPacket->getInterfaceId(), this->analogPacket->getStreamId()};
+    this->publisher.publish(endpoint, this->analogPacket);
+    auto secondPacket = this->template createAnalogPacket<TypeParam>();
+    secondPacket->setTimestamp(this->analogPacket->getTimestamp() + (this->analogDataSize + 1) * this->deltaT);
+    this->publisher.publish(endpoint, secondPacket);
+    auto thirdPacket = this->template createAnalogPacket<TypeParam>();
+    thirdPacket->setTimestamp(secondPacket->getTimestamp() + this->analogDataSize * this->deltaT);
+    this->publisher.publish(endpoint, thirdPacket);
+
+    std::vector<SizeT> sampleCounts;
+    std::vector<Int> offsets;
+    for (const auto& packet : reader.readAll())
+    {
+        if (packet.getType() == PacketType::Data)
+        {
+            const auto dataPacket = packet.asPtr<IDataPacket>();
+            sampleCounts.push_back(dataPacket.getSampleCount());
+            offsets.push_back(static_cast<Int>(dataPacket.getDomainPacket().getOffset()));
+        }
+    }
+    ASSERT_EQ(sampleCounts, (std::vector<SizeT>{this->analogDataSize, this->analogDataSize * 2}));
+    const std::vector<Int> expectedOffsets{static_cast<Int>(this->analogPacket->getTimestamp()),
+                                           static_cast<Int>(secondPacket->getTimestamp())};
+    ASSERT_EQ(offsets, expectedOffsets);
+}
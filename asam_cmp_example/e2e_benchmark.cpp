@@ -0,0 +1,562 @@
+#include <opendaq/context_factory.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/data_rule_factory.h>
+#include <opendaq/dimension_factory.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/range_factory.h>
+#include <opendaq/reader_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <opendaq/search_filter_factory.h>
+#include <opendaq/signal_factory.h>
+#include <coreobjects/unit_factory.h>
+
+#include <asam_cmp_capture_module/capture_module_fb.h>
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_data_sink/data_sink_module_fb.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace daq;
+using namespace std::chrono_literals;
+using asam_cmp_common_lib::LatencyHistogram;
+
+namespace
+{
+
+enum class PayloadKind : Int
+{
+    can = 1,
+    canFd = 2,
+    analog = 3
+};
+
+struct Options
+{
+    size_t interfaces{3};
+    size_t streams{2};
+    std::vector<PayloadKind> payloadTypes{PayloadKind::can, PayloadKind::canFd, PayloadKind::analog};
+    double canRate{1000};
+    double analogRate{10000};
+    double duration{10};
+    double warmup{2};
+    std::string backend{"loopback"};
+    std::string adapter;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: asam_cmp_e2e_benchmark [options]\n"
+                 "  --interfaces=N      number of capture interfaces (default 3)\n"
+                 "  --streams=M         number of streams per interface (default 2)\n"
+                 "  --types=LIST        comma separated payload types assigned to interfaces round-robin: can, canfd, analog\n"
+                 "                      (default can,canfd,analog)\n"
+                 "  --can-rate=R        CAN / CAN FD messages per second per stream (default 1000)\n"
+                 "  --analog-rate=R     analog samples per second per stream, at most 1000000 (default 10000)\n"
+                 "  --duration=S        measurement duration in seconds (default 10)\n"
+                 "  --warmup=S          warm-up duration in seconds, excluded from the results (default 2)\n"
+                 "  --backend=NAME      loopback (in-process) or pcap (default loopback)\n"
+                 "  --adapter=NAME      network adapter used by the pcap backend (default: first available)\n";
+}
+
+std::vector<PayloadKind> parsePayloadTypes(const std::string& value)
+{
+    std::vector<PayloadKind> types;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (item == "can")
+            types.push_back(PayloadKind::can);
+        else if (item == "canfd")
+            types.push_back(PayloadKind::canFd);
+        else if (item == "analog")
+            types.push_back(PayloadKind::analog);
+        else
+            throw std::invalid_argument("Unknown payload type: " + item);
+    }
+
+    if (types.empty())
+        throw std::invalid_argument("At least one payload type is required");
+    return types;
+}
+
+Options parseOptions(int argc, char** args)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = args[i];
+        const auto separator = arg.find('=');
+        const auto name = arg.substr(0, separator);
+        const auto value = separator == std::string::npos ? std::string() : arg.substr(separator + 1);
+
+        if (name == "--interfaces")
+            options.interfaces = std::stoul(value);
+        else if (name == "--streams")
+            options.streams = std::stoul(value);
+        else if (name == "--types")
+            options.payloadTypes = parsePayloadTypes(value);
+        else if (name == "--can-rate")
+            options.canRate = std::stod(value);
+        else if (name == "--analog-rate")
+            options.analogRate = std::min(std::stod(value), 1e6);
+        else if (name == "--duration")
+            options.duration = std::stod(value);
+        else if (name == "--warmup")
+            options.warmup = std::stod(value);
+        else if (name == "--backend")
+            options.backend = value;
+        else if (name == "--adapter")
+            options.adapter = value;
+        else
+            throw std::invalid_argument("Unknown option: " + arg);
+    }
+
+    if (options.backend != "loopback" && options.backend != "pcap")
+        throw std::invalid_argument("Unknown backend: " + options.backend);
+    return options;
+}
+
+int64_t getCurrentTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+double getProcessCpuTime()
+{
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+    auto toSeconds = [](const FILETIME& time)
+    { return (static_cast<uint64_t>(time.dwHighDateTime) << 32 | time.dwLowDateTime) * 1e-7; };
+    return toSeconds(kernelTime) + toSeconds(userTime);
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+std::string getEpoch()
+{
+    const std::time_t epochTime = std::chrono::system_clock::to_time_t(std::chrono::time_point<std::chrono::system_clock>{});
+
+    char buf[48];
+    strftime(buf, sizeof buf, "%Y-%m-%dT%H:%M:%SZ", gmtime(&epochTime));
+
+    return {buf};
+}
+
+#pragma pack(push, 1)
+struct CANData
+{
+    int32_t arbId;
+    int8_t length;
+    uint8_t data[64];
+};
+#pragma pack(pop)
+
+// Feeds a capture module stream with messages stamped with the wall-clock time they are generated at
+class Source
+{
+public:
+    Source(const ContextPtr& context, PayloadKind kind, double rate, size_t index)
+        : kind(kind)
+        , rate(rate)
+        , index(index)
+    {
+        const auto id = "source_" + std::to_string(index);
+        timeSignal = SignalWithDescriptor(context, buildTimeDescriptor(), nullptr, id + "_time");
+        valueSignal = SignalWithDescriptor(context, buildValueDescriptor(), nullptr, id);
+        valueSignal.setDomainSignal(timeSignal);
+    }
+
+    const SignalConfigPtr& getSignal() const
+    {
+        return valueSignal;
+    }
+
+    PayloadKind getKind() const
+    {
+        return kind;
+    }
+
+    uint64_t getSentCount() const
+    {
+        return sent;
+    }
+
+    void generate(int64_t now)
+    {
+        if (startTime == 0)
+            startTime = now;
+
+        if (kind == PayloadKind::analog)
+            generateAnalog(now);
+        else
+            generateCan(now);
+    }
+
+private:
+    DataDescriptorPtr buildValueDescriptor() const
+    {
+        if (kind == PayloadKind::analog)
+        {
+            return DataDescriptorBuilder()
+                .setSampleType(SampleType::Float64)
+                .setValueRange(Range(-10.0, 10.0))
+                .setUnit(Unit("V", -1, "volts", "voltage"))
+                .setName("AI")
+                .build();
+        }
+
+        const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+        const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+        const auto dataDescriptor =
+            DataDescriptorBuilder()
+                .setName("Data")
+                .setSampleType(SampleType::UInt8)
+                .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+                .build();
+
+        return DataDescriptorBuilder()
+            .setSampleType(SampleType::Struct)
+            .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+            .setName("CAN")
+            .build();
+    }
+
+    // The capture module expects analog domains in microseconds; CAN domains may use any 1/N resolution
+    DataDescriptorPtr buildTimeDescriptor()
+    {
+        auto builder = DataDescriptorBuilder().setSampleType(SampleType::Int64).setUnit(Unit("s", -1, "seconds", "time")).setOrigin(getEpoch());
+
+        if (kind == PayloadKind::analog)
+        {
+            analogDeltaUs = std::max<int64_t>(1, std::llround(1e6 / rate));
+            builder.setTickResolution(Ratio(1, 1000000)).setRule(LinearDataRule(analogDeltaUs, 0));
+        }
+        else
+        {
+            builder.setTickResolution(Ratio(1, 1000000000));
+        }
+
+        return builder.setName("Time").build();
+    }
+
+    void generateCan(int64_t now)
+    {
+        const auto due = static_cast<uint64_t>((now - startTime) * 1e-9 * rate) + 1;
+        if (due <= sent)
+            return;
+
+        const size_t count = due - sent;
+        const auto domainPacket = DataPacket(timeSignal.getDescriptor(), count, 0);
+        const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), count);
+
+        auto* canData = static_cast<CANData*>(dataPacket.getRawData());
+        auto* timeBuffer = static_cast<int64_t*>(domainPacket.getRawData());
+        for (size_t i = 0; i < count; ++i)
+        {
+            canData[i].arbId = static_cast<int32_t>((index << 4) + (sent + i) % 16);
+            canData[i].length = kind == PayloadKind::canFd ? 64 : 8;
+            std::fill(std::begin(canData[i].data), std::end(canData[i].data), static_cast<uint8_t>(sent + i));
+            timeBuffer[i] = now;
+        }
+        sent += count;
+
+        valueSignal.sendPacket(dataPacket);
+        timeSignal.sendPacket(domainPacket);
+    }
+
+    void generateAnalog(int64_t now)
+    {
+        const int64_t startUs = startTime / 1000;
+        const auto available = static_cast<uint64_t>((now / 1000 - startUs) / analogDeltaUs) + 1;
+        if (available <= sent)
+            return;
+
+        const size_t count = available - sent;
+        const auto domainPacket = DataPacket(timeSignal.getDescriptor(), count, startUs + static_cast<int64_t>(sent) * analogDeltaUs);
+        const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), count);
+
+        auto* values = static_cast<double*>(dataPacket.getRawData());
+        for (size_t i = 0; i < count; ++i)
+            values[i] = static_cast<double>((sent + i) % 200) / 10.0 - 10.0;
+        sent += count;
+
+        valueSignal.sendPacket(dataPacket);
+        timeSignal.sendPacket(domainPacket);
+    }
+
+private:
+    const PayloadKind kind;
+    const double rate;
+    const size_t index;
+    int64_t analogDeltaUs{1};
+
+    SignalConfigPtr timeSignal;
+    SignalConfigPtr valueSignal;
+    int64_t startTime{0};
+    uint64_t sent{0};
+};
+
+// Drains a data sink stream output signal; the last domain value of every packet is the send time of its newest message
+class Sink
+{
+public:
+    Sink(const SignalPtr& signal, PayloadKind kind)
+        : reader(PacketReader(signal))
+        , kind(kind)
+    {
+    }
+
+    PayloadKind getKind() const
+    {
+        return kind;
+    }
+
+    uint64_t getReceivedCount() const
+    {
+        return received;
+    }
+
+    void read(LatencyHistogram* latency)
+    {
+        const auto packets = reader.readAll();
+        const auto now = getCurrentTimeNs();
+
+        for (const auto& packet : packets)
+        {
+            if (packet.getType() != PacketType::Data)
+                continue;
+
+            const DataPacketPtr dataPacket = packet;
+            const size_t count = dataPacket.getSampleCount();
+            received += count;
+
+            const auto domainPacket = dataPacket.getDomainPacket();
+            if (!latency || count == 0 || !domainPacket.assigned())
+                continue;
+
+            const auto sendTime = static_cast<const uint64_t*>(domainPacket.getData())[count - 1];
+            if (static_cast<uint64_t>(now) > sendTime)
+                latency->record(now - sendTime);
+        }
+    }
+
+private:
+    PacketReaderPtr reader;
+    const PayloadKind kind;
+    uint64_t received{0};
+};
+
+FunctionBlockPtr findFunctionBlock(const FunctionBlockPtr& parent, const std::string& localId)
+{
+    return parent.getFunctionBlocks(search::Custom([&localId](const ComponentPtr& comp) { return comp.getLocalId() == localId; }))[0];
+}
+
+void selectNetworkAdapter(const FunctionBlockPtr& fb, const std::string& adapter)
+{
+    const ListPtr<IString> adapters = fb.getProperty("NetworkAdapters").getSelectionValues();
+    for (size_t i = 0; i < adapters.getCount(); ++i)
+    {
+        if (adapters[i].toStdString() == adapter)
+        {
+            fb.setPropertyValue("NetworkAdapters", static_cast<Int>(i));
+            return;
+        }
+    }
+
+    throw std::invalid_argument("Unknown network adapter: " + adapter);
+}
+
+struct Snapshot
+{
+    double time{0};
+    double cpuTime{0};
+    uint64_t messages{0};
+    uint64_t samples{0};
+    uint64_t frames{0};
+    uint64_t lostFrames{0};
+    uint64_t droppedFrames{0};
+};
+
+}  // namespace
+
+int main(int argc, char** args)
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, args);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    const auto logger = Logger();
+    const auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr);
+
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> captureEthernet;
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> sinkEthernet;
+    if (options.backend == "loopback")
+    {
+        captureEthernet = sinkEthernet = std::make_shared<asam_cmp_common_lib::EthernetLoopbackImpl>();
+    }
+    else
+    {
+        captureEthernet = std::make_shared<asam_cmp_common_lib::EthernetPcppImpl>();
+        sinkEthernet = std::make_shared<asam_cmp_common_lib::EthernetPcppImpl>();
+    }
+
+    const auto captureModuleFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_capture_module::CaptureModuleFb>(
+        context, nullptr, "asam_cmp_capture_module", captureEthernet);
+    const auto dataSinkModuleFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::DataSinkModuleFb>(
+        context, nullptr, "asam_cmp_data_sink_module", sinkEthernet);
+
+    if (!options.adapter.empty())
+    {
+        selectNetworkAdapter(captureModuleFb, options.adapter);
+        selectNetworkAdapter(dataSinkModuleFb, options.adapter);
+    }
+    else if (captureModuleFb.getPropertySelectionValue("NetworkAdapters") != dataSinkModuleFb.getPropertySelectionValue("NetworkAdapters"))
+    {
+        dataSinkModuleFb.setPropertyValue("NetworkAdapters", captureModuleFb.getPropertyValue("NetworkAdapters"));
+    }
+
+    // Mirror the capture module topology on the data sink side
+    const auto captureFb = findFunctionBlock(captureModuleFb, "asam_cmp_capture");
+    const auto dataSinkFb = findFunctionBlock(dataSinkModuleFb, "asam_cmp_data_sink");
+    ProcedurePtr(dataSinkFb.getPropertyValue("AddCaptureModuleEmpty"))();
+    const auto sinkCaptureFb = dataSinkFb.getFunctionBlocks()[0];
+    sinkCaptureFb.setPropertyValue("DeviceId", captureFb.getPropertyValue("DeviceId"));
+
+    std::vector<std::unique_ptr<Source>> sources;
+    std::vector<std::unique_ptr<Sink>> sinks;
+    for (size_t i = 0; i < options.interfaces; ++i)
+    {
+        const auto kind = options.payloadTypes[i % options.payloadTypes.size()];
+
+        ProcedurePtr(captureFb.getPropertyValue("AddInterface"))();
+        const auto itf = captureFb.getFunctionBlocks()[i];
+        itf.setPropertyValue("PayloadType", static_cast<Int>(kind));
+
+        ProcedurePtr(sinkCaptureFb.getPropertyValue("AddInterface"))();
+        const auto sinkItf = sinkCaptureFb.getFunctionBlocks()[i];
+        sinkItf.setPropertyValue("InterfaceId", itf.getPropertyValue("InterfaceId"));
+        sinkItf.setPropertyValue("PayloadType", static_cast<Int>(kind));
+
+        for (size_t j = 0; j < options.streams; ++j)
+        {
+            ProcedurePtr(itf.getPropertyValue("AddStream"))();
+            const auto stream = itf.getFunctionBlocks()[j];
+
+            ProcedurePtr(sinkItf.getPropertyValue("AddStream"))();
+            const auto sinkStream = sinkItf.getFunctionBlocks()[j];
+            sinkStream.setPropertyValue("StreamId", stream.getPropertyValue("StreamId"));
+
+            const double rate = kind == PayloadKind::analog ? options.analogRate : options.canRate;
+            sources.push_back(std::make_unique<Source>(context, kind, rate, sources.size()));
+            sinks.push_back(std::make_unique<Sink>(sinkStream.getSignals()[0], kind));
+            stream.getInputPorts()[0].connect(sources.back()->getSignal());
+        }
+    }
+
+    std::cout << "Running " << sources.size() << " streams over the " << options.backend << " backend for " << options.warmup << " s warm-up + "
+              << options.duration << " s" << std::endl;
+
+    std::atomic_bool generating{true};
+    std::thread generator(
+        [&]
+        {
+            auto next = std::chrono::steady_clock::now();
+            while (generating)
+            {
+                const auto now = getCurrentTimeNs();
+                for (auto& source : sources)
+                    source->generate(now);
+
+                next += 1ms;
+                std::this_thread::sleep_until(next);
+            }
+        });
+
+    LatencyHistogram latency;
+    const auto startTime = std::chrono::steady_clock::now();
+    auto takeSnapshot = [&]
+    {
+        Snapshot snapshot;
+        snapshot.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        snapshot.cpuTime = getProcessCpuTime();
+        for (const auto& sink : sinks)
+            (sink->getKind() == PayloadKind::analog ? snapshot.samples : snapshot.messages) += sink->getReceivedCount();
+        snapshot.frames = static_cast<Int>(dataSinkModuleFb.getPropertyValue("ReceivedFrames"));
+        snapshot.lostFrames = static_cast<Int>(sinkCaptureFb.getPropertyValue("LostMessages"));
+        snapshot.droppedFrames = static_cast<Int>(dataSinkModuleFb.getPropertyValue("DroppedByKernel")) +
+                                 static_cast<Int>(dataSinkModuleFb.getPropertyValue("DroppedByInterface"));
+        return snapshot;
+    };
+    auto readFor = [&](std::chrono::duration<double> duration, bool recordLatency)
+    {
+        const auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            for (auto& sink : sinks)
+                sink->read(recordLatency ? &latency : nullptr);
+            std::this_thread::sleep_for(1ms);
+        }
+    };
+
+    readFor(std::chrono::duration<double>(options.warmup), false);
+    const auto begin = takeSnapshot();
+    readFor(std::chrono::duration<double>(options.duration), true);
+    const auto end = takeSnapshot();
+
+    generating = false;
+    generator.join();
+    readFor(500ms, false);
+
+    uint64_t sentMessages = 0, sentSamples = 0, receivedMessages = 0, receivedSamples = 0;
+    for (const auto& source : sources)
+        (source->getKind() == PayloadKind::analog ? sentSamples : sentMessages) += source->getSentCount();
+    for (const auto& sink : sinks)
+        (sink->getKind() == PayloadKind::analog ? receivedSamples : receivedMessages) += sink->getReceivedCount();
+
+    const double elapsed = end.time - begin.time;
+    const uint64_t messages = end.messages - begin.messages;
+    const uint64_t samples = end.samples - begin.samples;
+    const uint64_t units = std::max<uint64_t>(messages + samples, 1);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "CAN / CAN FD messages/s:      " << messages / elapsed << "\n";
+    std::cout << "Analog samples/s:             " << samples / elapsed << "\n";
+    std::cout << "CMP frames/s:                 " << (end.frames - begin.frames) / elapsed << "\n";
+    std::cout << "CPU per message or sample:    " << (end.cpuTime - begin.cpuTime) / units * 1e9 << " ns\n";
+    std::cout << "CPU load:                     " << (end.cpuTime - begin.cpuTime) / elapsed * 100.0 << " %\n";
+    std::cout << "Lost CMP frames (seq. gaps):  " << end.lostFrames - begin.lostFrames << "\n";
+    std::cout << "Frames dropped by capture:    " << end.droppedFrames - begin.droppedFrames << "\n";
+    std::cout << "Undelivered messages:         " << sentMessages - std::min(sentMessages, receivedMessages) << " of " << sentMessages << "\n";
+    std::cout << "Undelivered analog samples:   " << sentSamples - std::min(sentSamples, receivedSamples) << " of " << sentSamples << "\n";
+    std::cout << "End-to-end latency, us:       p50 " << latency.getPercentile(50.0) / 1e3 << ", p99 " << latency.getPercentile(99.0) / 1e3
+              << ", p99.9 " << latency.getPercentile(99.9) / 1e3 << ", max " << latency.getMax() / 1e3 << std::endl;
+
+    return 0;
+}